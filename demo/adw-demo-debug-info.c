@@ -145,9 +145,13 @@ adw_demo_generate_debug_info (void)
     const char *builder = g_getenv ("INSIDE_GNOME_BUILDER");
     const char *gtk_debug = g_getenv ("GTK_DEBUG");
     const char *gtk_theme = g_getenv ("GTK_THEME");
+    const char *adw_debug = g_getenv ("ADW_DEBUG");
     const char *adw_debug_color_scheme = g_getenv ("ADW_DEBUG_COLOR_SCHEME");
     const char *adw_debug_high_contrast = g_getenv ("ADW_DEBUG_HIGH_CONTRAST");
     const char *adw_disable_portal = g_getenv ("ADW_DISABLE_PORTAL");
+    const char *adw_portal_timeout = g_getenv ("ADW_PORTAL_TIMEOUT");
+    const char *adw_disable_settings_cache = g_getenv ("ADW_DISABLE_SETTINGS_CACHE");
+    const char *adw_swipe_record = g_getenv ("ADW_SWIPE_RECORD");
 
     g_string_append (string, "Environment:\n");
     g_string_append_printf (string, "- Desktop: %s\n", desktop);
@@ -160,12 +164,20 @@ adw_demo_generate_debug_info (void)
       g_string_append_printf (string, "- GTK_DEBUG: %s\n", gtk_debug);
     if (gtk_theme)
       g_string_append_printf (string, "- GTK_THEME: %s\n", gtk_theme);
+    if (adw_debug)
+      g_string_append_printf (string, "- ADW_DEBUG: %s\n", adw_debug);
     if (adw_debug_color_scheme)
       g_string_append_printf (string, "- ADW_DEBUG_COLOR_SCHEME: %s\n", adw_debug_color_scheme);
     if (adw_debug_high_contrast)
       g_string_append_printf (string, "- ADW_DEBUG_HIGH_CONTRAST: %s\n", adw_debug_high_contrast);
     if (adw_disable_portal)
       g_string_append_printf (string, "- ADW_DISABLE_PORTAL: %s\n", adw_disable_portal);
+    if (adw_portal_timeout)
+      g_string_append_printf (string, "- ADW_PORTAL_TIMEOUT: %s\n", adw_portal_timeout);
+    if (adw_disable_settings_cache)
+      g_string_append_printf (string, "- ADW_DISABLE_SETTINGS_CACHE: %s\n", adw_disable_settings_cache);
+    if (adw_swipe_record)
+      g_string_append_printf (string, "- ADW_SWIPE_RECORD: %s\n", adw_swipe_record);
   }
 
   return g_string_free_and_steal (string);
@@ -10,9 +10,15 @@
 
 #include "adw-breakpoint-bin-private.h"
 
+#include "adw-animation-util.h"
 #include "adw-breakpoint-private.h"
+#include "adw-enums.h"
 #include "adw-widget-utils-private.h"
 
+#include <math.h>
+
+#define TEXTURE_SNAPSHOT_SCALE 0.5
+
 /**
  * AdwBreakpointBin:
  *
@@ -128,9 +134,38 @@
  *
  * See [class@Breakpoint] documentation for details.
  *
+ * ## Breakpoint Transitions
+ *
+ * When the current breakpoint changes, `AdwBreakpointBin` keeps showing a
+ * snapshot of the old layout until the new one has been allocated, so that
+ * intermediate states are never visible. This requires allocating and
+ * snapshotting the child one extra time, which can be expensive for large
+ * widget trees.
+ *
+ * The [property@BreakpointBin:snapshot-mode] property controls how that
+ * snapshot is taken. If [property@Gtk.Settings:gtk-enable-animations] is
+ * `FALSE`, no snapshot is taken regardless of its value.
+ *
  * Since: 1.4
  */
 
+/**
+ * AdwBreakpointSnapshotMode:
+ * @ADW_BREAKPOINT_SNAPSHOT_FULL: Keep the full render node tree of the old
+ *   layout
+ * @ADW_BREAKPOINT_SNAPSHOT_TEXTURE: Render the old layout into a texture at a
+ *   reduced resolution
+ * @ADW_BREAKPOINT_SNAPSHOT_NONE: Don't snapshot the old layout and allocate the
+ *   new one immediately
+ *
+ * Describes how [class@BreakpointBin] snapshots its old layout when the
+ * current breakpoint changes.
+ *
+ * See [property@BreakpointBin:snapshot-mode].
+ *
+ * Since: 1.5
+ */
+
 typedef struct {
   gboolean grab_focus;
   GtkDirectionType direction;
@@ -144,6 +179,7 @@ typedef struct
   AdwBreakpoint *current_breakpoint;
 
   GskRenderNode *old_node;
+  AdwBreakpointSnapshotMode snapshot_mode;
   gboolean first_allocation;
   guint tick_cb_id;
 
@@ -172,6 +208,7 @@ enum {
   PROP_0,
   PROP_CHILD,
   PROP_CURRENT_BREAKPOINT,
+  PROP_SNAPSHOT_MODE,
   LAST_PROP,
 };
 
@@ -266,7 +303,7 @@ breakpoint_changed_tick_cb (GtkWidget        *widget,
   int i;
 
   priv->tick_cb_id = 0;
-  priv->old_node = NULL;
+  g_clear_pointer (&priv->old_node, gsk_render_node_unref);
   gtk_widget_set_child_visible (priv->child, TRUE);
   gtk_widget_queue_resize (GTK_WIDGET (self));
 
@@ -284,6 +321,71 @@ breakpoint_changed_tick_cb (GtkWidget        *widget,
   return G_SOURCE_REMOVE;
 }
 
+static gboolean
+should_snapshot (AdwBreakpointBin *self)
+{
+  AdwBreakpointBinPrivate *priv = adw_breakpoint_bin_get_instance_private (self);
+
+  if (priv->first_allocation)
+    return FALSE;
+
+  if (priv->snapshot_mode == ADW_BREAKPOINT_SNAPSHOT_NONE)
+    return FALSE;
+
+  return adw_get_enable_animations (GTK_WIDGET (self));
+}
+
+static GskRenderNode *
+render_to_texture (AdwBreakpointBin *self,
+                   GskRenderNode    *node,
+                   int               width,
+                   int               height)
+{
+  GtkNative *native = gtk_widget_get_native (GTK_WIDGET (self));
+  GskRenderer *renderer;
+  GskRenderNode *scaled_node;
+  GdkTexture *texture;
+  GtkSnapshot *snapshot;
+  int texture_width, texture_height;
+
+  if (!native || width <= 0 || height <= 0)
+    return node;
+
+  renderer = gtk_native_get_renderer (native);
+
+  if (!renderer || !gsk_renderer_is_realized (renderer))
+    return node;
+
+  texture_width = (int) ceil (width * TEXTURE_SNAPSHOT_SCALE);
+  texture_height = (int) ceil (height * TEXTURE_SNAPSHOT_SCALE);
+
+  snapshot = gtk_snapshot_new ();
+  gtk_snapshot_scale (snapshot, TEXTURE_SNAPSHOT_SCALE, TEXTURE_SNAPSHOT_SCALE);
+  gtk_snapshot_append_node (snapshot, node);
+  scaled_node = gtk_snapshot_free_to_node (snapshot);
+
+  gsk_render_node_unref (node);
+
+  if (!scaled_node)
+    return NULL;
+
+  texture = gsk_renderer_render_texture (renderer, scaled_node,
+                                         &GRAPHENE_RECT_INIT (0, 0,
+                                                              texture_width,
+                                                              texture_height));
+
+  gsk_render_node_unref (scaled_node);
+
+  snapshot = gtk_snapshot_new ();
+  gtk_snapshot_append_scaled_texture (snapshot, texture,
+                                      GSK_SCALING_FILTER_LINEAR,
+                                      &GRAPHENE_RECT_INIT (0, 0, width, height));
+
+  g_object_unref (texture);
+
+  return gtk_snapshot_free_to_node (snapshot);
+}
+
 static void
 breakpoint_notify_condition_cb (AdwBreakpointBin *self)
 {
@@ -394,6 +496,7 @@ adw_breakpoint_bin_size_allocate (GtkWidget *widget,
   GtkSnapshot *snapshot;
   AdwBreakpoint *new_breakpoint = NULL;
   GtkSettings *settings;
+  gboolean take_snapshot;
 
   if (!priv->child)
     return;
@@ -416,7 +519,9 @@ adw_breakpoint_bin_size_allocate (GtkWidget *widget,
     return;
   }
 
-  if (!priv->first_allocation) {
+  take_snapshot = should_snapshot (self);
+
+  if (take_snapshot) {
     priv->block_warnings = TRUE;
     allocate_child (self, width, height, baseline);
     priv->block_warnings = FALSE;
@@ -426,6 +531,9 @@ adw_breakpoint_bin_size_allocate (GtkWidget *widget,
 
     priv->old_node = gtk_snapshot_free_to_node (snapshot);
 
+    if (priv->old_node && priv->snapshot_mode == ADW_BREAKPOINT_SNAPSHOT_TEXTURE)
+      priv->old_node = render_to_texture (self, priv->old_node, width, height);
+
     gtk_widget_set_child_visible (priv->child, FALSE);
   }
 
@@ -434,7 +542,7 @@ adw_breakpoint_bin_size_allocate (GtkWidget *widget,
   priv->current_breakpoint = new_breakpoint;
   g_object_notify_by_pspec (G_OBJECT (self), props[PROP_CURRENT_BREAKPOINT]);
 
-  if (priv->first_allocation) {
+  if (!take_snapshot) {
     priv->block_warnings = TRUE;
     allocate_child (self, width, height, baseline);
     priv->block_warnings = FALSE;
@@ -511,6 +619,8 @@ adw_breakpoint_bin_dispose (GObject *object)
     priv->tick_cb_id = 0;
   }
 
+  g_clear_pointer (&priv->old_node, gsk_render_node_unref);
+
   if (priv->breakpoints) {
     g_list_free_full (priv->breakpoints, g_object_unref);
     priv->breakpoints = NULL;
@@ -536,6 +646,9 @@ adw_breakpoint_bin_get_property (GObject    *object,
   case PROP_CURRENT_BREAKPOINT:
     g_value_set_object (value, adw_breakpoint_bin_get_current_breakpoint (self));
     break;
+  case PROP_SNAPSHOT_MODE:
+    g_value_set_enum (value, adw_breakpoint_bin_get_snapshot_mode (self));
+    break;
   default:
     G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
   }
@@ -553,6 +666,9 @@ adw_breakpoint_bin_set_property (GObject      *object,
   case PROP_CHILD:
     adw_breakpoint_bin_set_child (self, g_value_get_object (value));
     break;
+  case PROP_SNAPSHOT_MODE:
+    adw_breakpoint_bin_set_snapshot_mode (self, g_value_get_enum (value));
+    break;
   default:
     G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
   }
@@ -602,6 +718,32 @@ adw_breakpoint_bin_class_init (AdwBreakpointBinClass *klass)
                          ADW_TYPE_BREAKPOINT,
                          G_PARAM_READABLE | G_PARAM_STATIC_STRINGS);
 
+  /**
+   * AdwBreakpointBin:snapshot-mode: (attributes org.gtk.Property.get=adw_breakpoint_bin_get_snapshot_mode org.gtk.Property.set=adw_breakpoint_bin_set_snapshot_mode)
+   *
+   * How to snapshot the old layout when the current breakpoint changes.
+   *
+   * `ADW_BREAKPOINT_SNAPSHOT_FULL` keeps the full render node tree of the
+   * child and is pixel-perfect.
+   *
+   * `ADW_BREAKPOINT_SNAPSHOT_TEXTURE` renders it into a texture at half
+   * resolution instead, which is cheaper to draw for complex widget trees.
+   *
+   * `ADW_BREAKPOINT_SNAPSHOT_NONE` skips the extra allocation and snapshot
+   * entirely, at the cost of intermediate layouts being potentially visible
+   * for a frame.
+   *
+   * If [property@Gtk.Settings:gtk-enable-animations] is `FALSE`, the old
+   * layout is never snapshotted.
+   *
+   * Since: 1.5
+   */
+  props[PROP_SNAPSHOT_MODE] =
+    g_param_spec_enum ("snapshot-mode", NULL, NULL,
+                       ADW_TYPE_BREAKPOINT_SNAPSHOT_MODE,
+                       ADW_BREAKPOINT_SNAPSHOT_FULL,
+                       G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS | G_PARAM_EXPLICIT_NOTIFY);
+
   g_object_class_install_properties (object_class, LAST_PROP, props);
 }
 
@@ -614,6 +756,7 @@ adw_breakpoint_bin_init (AdwBreakpointBin *self)
   priv->natural_height = -1;
   priv->enable_min_size_warnings = TRUE;
   priv->enable_overflow_warnings = TRUE;
+  priv->snapshot_mode = ADW_BREAKPOINT_SNAPSHOT_FULL;
 
   priv->delayed_focus = g_array_new (FALSE, FALSE, sizeof (DelayedFocus));
 
@@ -798,6 +941,58 @@ adw_breakpoint_bin_get_current_breakpoint (AdwBreakpointBin *self)
   return priv->current_breakpoint;
 }
 
+/**
+ * adw_breakpoint_bin_get_snapshot_mode: (attributes org.gtk.Method.get_property=snapshot-mode)
+ * @self: a breakpoint bin
+ *
+ * Gets how @self snapshots its old layout when the current breakpoint changes.
+ *
+ * Returns: the snapshot mode
+ *
+ * Since: 1.5
+ */
+AdwBreakpointSnapshotMode
+adw_breakpoint_bin_get_snapshot_mode (AdwBreakpointBin *self)
+{
+  AdwBreakpointBinPrivate *priv;
+
+  g_return_val_if_fail (ADW_IS_BREAKPOINT_BIN (self), ADW_BREAKPOINT_SNAPSHOT_FULL);
+
+  priv = adw_breakpoint_bin_get_instance_private (self);
+
+  return priv->snapshot_mode;
+}
+
+/**
+ * adw_breakpoint_bin_set_snapshot_mode: (attributes org.gtk.Method.set_property=snapshot-mode)
+ * @self: a breakpoint bin
+ * @mode: the snapshot mode
+ *
+ * Sets how @self snapshots its old layout when the current breakpoint changes.
+ *
+ * See [property@BreakpointBin:snapshot-mode].
+ *
+ * Since: 1.5
+ */
+void
+adw_breakpoint_bin_set_snapshot_mode (AdwBreakpointBin          *self,
+                                      AdwBreakpointSnapshotMode  mode)
+{
+  AdwBreakpointBinPrivate *priv;
+
+  g_return_if_fail (ADW_IS_BREAKPOINT_BIN (self));
+  g_return_if_fail (mode <= ADW_BREAKPOINT_SNAPSHOT_NONE);
+
+  priv = adw_breakpoint_bin_get_instance_private (self);
+
+  if (priv->snapshot_mode == mode)
+    return;
+
+  priv->snapshot_mode = mode;
+
+  g_object_notify_by_pspec (G_OBJECT (self), props[PROP_SNAPSHOT_MODE]);
+}
+
 void
 adw_breakpoint_bin_set_warnings (AdwBreakpointBin *self,
                                  gboolean          min_size_warnings,
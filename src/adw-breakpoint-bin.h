@@ -22,6 +22,12 @@ G_BEGIN_DECLS
 
 #define ADW_TYPE_BREAKPOINT_BIN (adw_breakpoint_bin_get_type())
 
+typedef enum {
+  ADW_BREAKPOINT_SNAPSHOT_FULL,
+  ADW_BREAKPOINT_SNAPSHOT_TEXTURE,
+  ADW_BREAKPOINT_SNAPSHOT_NONE,
+} AdwBreakpointSnapshotMode;
+
 ADW_AVAILABLE_IN_1_4
 G_DECLARE_DERIVABLE_TYPE (AdwBreakpointBin, adw_breakpoint_bin, ADW, BREAKPOINT_BIN, GtkWidget)
 
@@ -53,4 +59,10 @@ void adw_breakpoint_bin_remove_breakpoint (AdwBreakpointBin *self,
 ADW_AVAILABLE_IN_1_4
 AdwBreakpoint *adw_breakpoint_bin_get_current_breakpoint (AdwBreakpointBin *self);
 
+ADW_AVAILABLE_IN_1_5
+AdwBreakpointSnapshotMode adw_breakpoint_bin_get_snapshot_mode (AdwBreakpointBin          *self);
+ADW_AVAILABLE_IN_1_5
+void                      adw_breakpoint_bin_set_snapshot_mode (AdwBreakpointBin          *self,
+                                                                AdwBreakpointSnapshotMode  mode);
+
 G_END_DECLS
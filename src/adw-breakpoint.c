@@ -138,6 +138,8 @@ typedef enum {
 
 struct _AdwBreakpointCondition
 {
+  gatomicrefcount ref_count;
+
   ConditionType type;
 
   union {
@@ -241,6 +243,7 @@ adw_breakpoint_condition_new_length (AdwBreakpointConditionLengthType type,
   g_return_val_if_fail (unit <= ADW_LENGTH_UNIT_SP, NULL);
 
   self = g_new0 (AdwBreakpointCondition, 1);
+  g_atomic_ref_count_init (&self->ref_count);
   self->type = CONDITION_LENGTH;
   self->data.length.type = type;
   self->data.length.value = value;
@@ -276,6 +279,7 @@ adw_breakpoint_condition_new_ratio (AdwBreakpointConditionRatioType type,
   g_return_val_if_fail (height >= 1, NULL);
 
   self = g_new0 (AdwBreakpointCondition, 1);
+  g_atomic_ref_count_init (&self->ref_count);
   self->type = CONDITION_RATIO;
   self->data.ratio.type = type;
   self->data.ratio.width = width;
@@ -306,6 +310,7 @@ adw_breakpoint_condition_new_and (AdwBreakpointCondition *condition_1,
   g_return_val_if_fail (condition_2 != NULL, NULL);
 
   self = g_new0 (AdwBreakpointCondition, 1);
+  g_atomic_ref_count_init (&self->ref_count);
   self->type = CONDITION_MULTI;
   self->data.multi.type = MULTI_CONDITION_ALL;
   self->data.multi.condition_1 = condition_1;
@@ -336,6 +341,7 @@ adw_breakpoint_condition_new_or (AdwBreakpointCondition *condition_1,
   g_return_val_if_fail (condition_2 != NULL, NULL);
 
   self = g_new0 (AdwBreakpointCondition, 1);
+  g_atomic_ref_count_init (&self->ref_count);
   self->type = CONDITION_MULTI;
   self->data.multi.type = MULTI_CONDITION_ANY;
   self->data.multi.condition_1 = condition_1;
@@ -350,6 +356,9 @@ adw_breakpoint_condition_new_or (AdwBreakpointCondition *condition_1,
  *
  * Copies @self.
  *
+ * Conditions are immutable, so the copy shares its data with @self and is
+ * cheap to make.
+ *
  * Returns: (transfer full): a copy of @self
  *
  * Since: 1.4
@@ -359,32 +368,9 @@ adw_breakpoint_condition_copy (AdwBreakpointCondition *self)
 {
   g_return_val_if_fail (self != NULL, NULL);
 
-  if (self->type == CONDITION_LENGTH) {
-    return adw_breakpoint_condition_new_length (self->data.length.type,
-                                                self->data.length.value,
-                                                self->data.length.unit);
-  }
-
-  if (self->type == CONDITION_RATIO) {
-    return adw_breakpoint_condition_new_ratio (self->data.ratio.type,
-                                               self->data.ratio.width,
-                                               self->data.ratio.height);
-  }
-
-  if (self->type == CONDITION_MULTI) {
-    switch (self->data.multi.type) {
-    case MULTI_CONDITION_ALL:
-      return adw_breakpoint_condition_new_and (adw_breakpoint_condition_copy (self->data.multi.condition_1),
-                                               adw_breakpoint_condition_copy (self->data.multi.condition_2));
-    case MULTI_CONDITION_ANY:
-      return adw_breakpoint_condition_new_or (adw_breakpoint_condition_copy (self->data.multi.condition_1),
-                                              adw_breakpoint_condition_copy (self->data.multi.condition_2));
-    default:
-      g_assert_not_reached ();
-    }
-  }
+  g_atomic_ref_count_inc (&self->ref_count);
 
-  g_assert_not_reached ();
+  return self;
 }
 
 /**
@@ -400,6 +386,9 @@ adw_breakpoint_condition_free (AdwBreakpointCondition *self)
 {
   g_return_if_fail (self != NULL);
 
+  if (!g_atomic_ref_count_dec (&self->ref_count))
+    return;
+
   if (self->type == CONDITION_MULTI) {
     adw_breakpoint_condition_free (self->data.multi.condition_1);
     adw_breakpoint_condition_free (self->data.multi.condition_2);
@@ -1184,6 +1173,37 @@ typedef struct {
   GString *condition;
 } ConditionParserData;
 
+static GHashTable *parsed_conditions;
+
+/*
+ * Templates are instantiated many times, and each instance would parse the
+ * same condition strings again. Since conditions are immutable, parse each
+ * string once and share the resulting condition between all breakpoints
+ * created from UI files.
+ */
+static AdwBreakpointCondition *
+parse_condition_cached (const char *str)
+{
+  AdwBreakpointCondition *condition;
+
+  if (G_UNLIKELY (!parsed_conditions))
+    parsed_conditions = g_hash_table_new_full (g_str_hash, g_str_equal, g_free,
+                                               (GDestroyNotify) adw_breakpoint_condition_free);
+
+  condition = g_hash_table_lookup (parsed_conditions, str);
+
+  if (condition)
+    return adw_breakpoint_condition_copy (condition);
+
+  condition = adw_breakpoint_condition_parse (str);
+
+  if (condition)
+    g_hash_table_insert (parsed_conditions, g_strdup (str),
+                         adw_breakpoint_condition_copy (condition));
+
+  return condition;
+}
+
 static void
 condition_data_free (gpointer data)
 {
@@ -1427,7 +1447,7 @@ adw_breakpoint_buildable_custom_finished (GtkBuildable *buildable,
     ConditionParserData *data = user_data;
     AdwBreakpointCondition *condition;
 
-    condition = adw_breakpoint_condition_parse (data->condition->str);
+    condition = parse_condition_cached (data->condition->str);
 
     if (condition) {
       adw_breakpoint_set_condition (ADW_BREAKPOINT (data->object), condition);
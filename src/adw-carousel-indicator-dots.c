@@ -20,6 +20,7 @@
 #define DOTS_OPACITY_SELECTED 0.9
 #define DOTS_SPACING 7
 #define DOTS_MARGIN 6
+#define DOTS_MAX_VISIBLE 15
 
 /**
  * AdwCarouselIndicatorDots:
@@ -53,6 +54,13 @@ struct _AdwCarouselIndicatorDots
 
   AdwAnimation *animation;
   GBinding *duration_binding;
+
+  GskRenderNode *static_dots;
+  guint static_dots_n_pages;
+  GtkOrientation static_dots_orientation;
+  double static_dots_x;
+  double static_dots_y;
+  GdkRGBA static_dots_color;
 };
 
 G_DEFINE_FINAL_TYPE_WITH_CODE (AdwCarouselIndicatorDots, adw_carousel_indicator_dots, GTK_TYPE_WIDGET,
@@ -70,25 +78,42 @@ enum {
 static GParamSpec *props[LAST_PROP];
 
 static void
-snapshot_dots (GtkWidget      *widget,
-               GtkSnapshot    *snapshot,
-               GtkOrientation  orientation,
-               double          position,
-               double         *sizes,
-               guint           n_pages)
+snapshot_dot (GtkSnapshot   *snapshot,
+              const GdkRGBA *color,
+              double         x,
+              double         y,
+              double         radius,
+              double         opacity)
 {
-  GdkRGBA color;
-  int i, widget_length, widget_thickness;
-  double x, y, indicator_length, dot_size, full_size;
-  double current_position, remaining_progress;
+  GdkRGBA dot_color = *color;
+  GskRoundedRect clip;
   graphene_rect_t rect;
 
-  gtk_widget_get_color (widget, &color);
-  dot_size = 2 * DOTS_RADIUS_SELECTED + DOTS_SPACING;
+  if (radius <= 0 || opacity <= 0)
+    return;
 
-  indicator_length = -DOTS_SPACING;
-  for (i = 0; i < n_pages; i++)
-    indicator_length += dot_size * sizes[i];
+  dot_color.alpha *= opacity;
+
+  graphene_rect_init (&rect, x - radius, y - radius, radius * 2, radius * 2);
+  gsk_rounded_rect_init_from_rect (&clip, &rect, radius);
+
+  gtk_snapshot_push_rounded_clip (snapshot, &clip);
+  gtk_snapshot_append_color (snapshot, &dot_color, &rect);
+  gtk_snapshot_pop (snapshot);
+}
+
+/* Returns the position of the start of the first dot */
+static void
+get_dots_origin (GtkWidget      *widget,
+                 GtkOrientation  orientation,
+                 double          indicator_length,
+                 double         *x,
+                 double         *y)
+{
+  int widget_length, widget_thickness;
+  double dot_size, full_size;
+
+  dot_size = 2 * DOTS_RADIUS_SELECTED + DOTS_SPACING;
 
   if (orientation == GTK_ORIENTATION_HORIZONTAL) {
     widget_length = gtk_widget_get_width (widget);
@@ -104,26 +129,60 @@ snapshot_dots (GtkWidget      *widget,
     widget_length--;
 
   if (orientation == GTK_ORIENTATION_HORIZONTAL) {
-    x = (widget_length - indicator_length) / 2.0;
-    y = widget_thickness / 2;
+    *x = (widget_length - indicator_length) / 2.0;
+    *y = widget_thickness / 2;
   } else {
-    x = widget_thickness / 2;
-    y = (widget_length - indicator_length) / 2.0;
+    *x = widget_thickness / 2;
+    *y = (widget_length - indicator_length) / 2.0;
   }
+}
+
+static inline void
+snapshot_dot_at (GtkSnapshot    *snapshot,
+                 const GdkRGBA  *color,
+                 GtkOrientation  orientation,
+                 double          x,
+                 double          y,
+                 double          offset,
+                 double          radius,
+                 double          opacity)
+{
+  if (orientation == GTK_ORIENTATION_HORIZONTAL)
+    snapshot_dot (snapshot, color, x + offset, y, radius, opacity);
+  else
+    snapshot_dot (snapshot, color, x, y + offset, radius, opacity);
+}
+
+static void
+snapshot_dots (GtkWidget      *widget,
+               GtkSnapshot    *snapshot,
+               GtkOrientation  orientation,
+               double          position,
+               double         *sizes,
+               guint           n_pages)
+{
+  GdkRGBA color;
+  int i;
+  double x, y, indicator_length, dot_size, offset;
+  double current_position, remaining_progress;
+
+  gtk_widget_get_color (widget, &color);
+  dot_size = 2 * DOTS_RADIUS_SELECTED + DOTS_SPACING;
+
+  indicator_length = -DOTS_SPACING;
+  for (i = 0; i < n_pages; i++)
+    indicator_length += dot_size * sizes[i];
+
+  get_dots_origin (widget, orientation, indicator_length, &x, &y);
 
+  offset = 0;
   current_position = 0;
   remaining_progress = 1;
 
-  graphene_rect_init (&rect, -DOTS_RADIUS, -DOTS_RADIUS, DOTS_RADIUS * 2, DOTS_RADIUS * 2);
-
   for (i = 0; i < n_pages; i++) {
     double progress, radius, opacity;
-    GskRoundedRect clip;
 
-    if (orientation == GTK_ORIENTATION_HORIZONTAL)
-      x += dot_size * sizes[i] / 2.0;
-    else
-      y += dot_size * sizes[i] / 2.0;
+    offset += dot_size * sizes[i] / 2.0;
 
     current_position += sizes[i];
 
@@ -133,26 +192,169 @@ snapshot_dots (GtkWidget      *widget,
     radius = adw_lerp (DOTS_RADIUS, DOTS_RADIUS_SELECTED, progress) * sizes[i];
     opacity = adw_lerp (DOTS_OPACITY, DOTS_OPACITY_SELECTED, progress) * sizes[i];
 
-    gsk_rounded_rect_init_from_rect (&clip, &rect, radius);
+    snapshot_dot_at (snapshot, &color, orientation, x, y, offset, radius, opacity);
+
+    offset += dot_size * sizes[i] / 2.0;
+  }
+}
 
-    gtk_snapshot_save (snapshot);
-    gtk_snapshot_translate (snapshot, &GRAPHENE_POINT_INIT (x, y));
-    gtk_snapshot_scale (snapshot, radius / DOTS_RADIUS, radius / DOTS_RADIUS);
+static GskRenderNode *
+ensure_static_dots (AdwCarouselIndicatorDots *self,
+                    const GdkRGBA            *color,
+                    double                    x,
+                    double                    y,
+                    guint                     n_pages)
+{
+  GtkSnapshot *snapshot;
+  double dot_size;
+  guint i;
 
-    gtk_snapshot_push_rounded_clip (snapshot, &clip);
-    gtk_snapshot_push_opacity (snapshot, opacity);
+  if (self->static_dots &&
+      self->static_dots_n_pages == n_pages &&
+      self->static_dots_orientation == self->orientation &&
+      G_APPROX_VALUE (self->static_dots_x, x, DBL_EPSILON) &&
+      G_APPROX_VALUE (self->static_dots_y, y, DBL_EPSILON) &&
+      gdk_rgba_equal (&self->static_dots_color, color))
+    return self->static_dots;
 
-    gtk_snapshot_append_color (snapshot, &color, &rect);
+  g_clear_pointer (&self->static_dots, gsk_render_node_unref);
 
+  dot_size = 2 * DOTS_RADIUS_SELECTED + DOTS_SPACING;
+  snapshot = gtk_snapshot_new ();
+
+  for (i = 0; i < n_pages; i++)
+    snapshot_dot_at (snapshot, color, self->orientation, x, y,
+                     dot_size * (i + 0.5), DOTS_RADIUS, DOTS_OPACITY);
+
+  self->static_dots = gtk_snapshot_free_to_node (snapshot);
+  self->static_dots_n_pages = n_pages;
+  self->static_dots_orientation = self->orientation;
+  self->static_dots_x = x;
+  self->static_dots_y = y;
+  self->static_dots_color = *color;
+
+  return self->static_dots;
+}
+
+/* When no pages are being added or removed, only the two dots around the
+ * current position change between frames, so draw the rest from a cached
+ * node clipped around them */
+static void
+snapshot_dots_static (AdwCarouselIndicatorDots *self,
+                      GtkSnapshot              *snapshot,
+                      double                    position,
+                      guint                     n_pages)
+{
+  GtkWidget *widget = GTK_WIDGET (self);
+  GskRenderNode *node;
+  GdkRGBA color;
+  graphene_rect_t bounds, clip;
+  double x, y, dot_size, window_start, window_end;
+  guint i, active;
+
+  gtk_widget_get_color (widget, &color);
+  dot_size = 2 * DOTS_RADIUS_SELECTED + DOTS_SPACING;
+
+  get_dots_origin (widget, self->orientation,
+                   dot_size * n_pages - DOTS_SPACING, &x, &y);
+
+  node = ensure_static_dots (self, &color, x, y, n_pages);
+  gsk_render_node_get_bounds (node, &bounds);
+
+  position = CLAMP (position, 0, n_pages - 1);
+  active = (guint) floor (position);
+
+  window_start = dot_size * active;
+  window_end = dot_size * MIN (active + 2, n_pages);
+
+  if (self->orientation == GTK_ORIENTATION_HORIZONTAL) {
+    window_start += x;
+    window_end += x;
+
+    graphene_rect_init (&clip, bounds.origin.x, bounds.origin.y,
+                        window_start - bounds.origin.x, bounds.size.height);
+  } else {
+    window_start += y;
+    window_end += y;
+
+    graphene_rect_init (&clip, bounds.origin.x, bounds.origin.y,
+                        bounds.size.width, window_start - bounds.origin.y);
+  }
+
+  if (clip.size.width > 0 && clip.size.height > 0) {
+    gtk_snapshot_push_clip (snapshot, &clip);
+    gtk_snapshot_append_node (snapshot, node);
     gtk_snapshot_pop (snapshot);
+  }
+
+  if (self->orientation == GTK_ORIENTATION_HORIZONTAL)
+    graphene_rect_init (&clip, window_end, bounds.origin.y,
+                        bounds.origin.x + bounds.size.width - window_end,
+                        bounds.size.height);
+  else
+    graphene_rect_init (&clip, bounds.origin.x, window_end, bounds.size.width,
+                        bounds.origin.y + bounds.size.height - window_end);
+
+  if (clip.size.width > 0 && clip.size.height > 0) {
+    gtk_snapshot_push_clip (snapshot, &clip);
+    gtk_snapshot_append_node (snapshot, node);
     gtk_snapshot_pop (snapshot);
+  }
 
-    gtk_snapshot_restore (snapshot);
+  for (i = active; i < MIN (active + 2, n_pages); i++) {
+    double progress = 1 - ABS (position - i);
 
-    if (orientation == GTK_ORIENTATION_HORIZONTAL)
-      x += dot_size * sizes[i] / 2.0;
-    else
-      y += dot_size * sizes[i] / 2.0;
+    snapshot_dot_at (snapshot, &color, self->orientation, x, y,
+                     dot_size * (i + 0.5),
+                     adw_lerp (DOTS_RADIUS, DOTS_RADIUS_SELECTED, progress),
+                     adw_lerp (DOTS_OPACITY, DOTS_OPACITY_SELECTED, progress));
+  }
+}
+
+/* With too many pages to fit, only show DOTS_MAX_VISIBLE dots around the
+ * current position, and shrink the dots at the edges if there are more pages
+ * past them */
+static void
+snapshot_dots_windowed (GtkWidget      *widget,
+                        GtkSnapshot    *snapshot,
+                        GtkOrientation  orientation,
+                        double          position,
+                        guint           n_pages)
+{
+  GdkRGBA color;
+  double x, y, dot_size;
+  double start, hidden_before, hidden_after;
+  int i, first, last;
+
+  gtk_widget_get_color (widget, &color);
+  dot_size = 2 * DOTS_RADIUS_SELECTED + DOTS_SPACING;
+
+  get_dots_origin (widget, orientation,
+                   dot_size * DOTS_MAX_VISIBLE - DOTS_SPACING, &x, &y);
+
+  position = CLAMP (position, 0, n_pages - 1);
+  start = CLAMP (position - (DOTS_MAX_VISIBLE - 1) / 2.0,
+                 0, n_pages - DOTS_MAX_VISIBLE);
+
+  hidden_before = MIN (start, 1);
+  hidden_after = MIN (n_pages - DOTS_MAX_VISIBLE - start, 1);
+
+  first = (int) floor (start);
+  last = MIN ((int) ceil (start + DOTS_MAX_VISIBLE) - 1, (int) n_pages - 1);
+
+  for (i = first; i <= last; i++) {
+    double offset, progress, scale;
+
+    offset = i - start;
+    progress = MAX (1 - ABS (position - i), 0);
+    scale = MIN ((offset + 1) / 2 + (1 - hidden_before) / 2,
+                 (DOTS_MAX_VISIBLE - offset) / 2 + (1 - hidden_after) / 2);
+    scale = CLAMP (scale, 0, 1);
+
+    snapshot_dot_at (snapshot, &color, orientation, x, y,
+                     dot_size * (offset + 0.5),
+                     adw_lerp (DOTS_RADIUS, DOTS_RADIUS_SELECTED, progress) * scale,
+                     adw_lerp (DOTS_OPACITY, DOTS_OPACITY_SELECTED, progress) * scale);
   }
 }
 
@@ -195,6 +397,8 @@ adw_carousel_indicator_dots_measure (GtkWidget      *widget,
     for (i = 0; i < n_points; i++)
       indicator_length += dot_size * sizes[i];
 
+    indicator_length = MIN (indicator_length, dot_size * DOTS_MAX_VISIBLE);
+
     size = ceil (indicator_length);
 
     g_free (points);
@@ -226,6 +430,7 @@ adw_carousel_indicator_dots_snapshot (GtkWidget   *widget,
   int i, n_points;
   double position;
   double *points, *sizes;
+  gboolean animating = FALSE;
 
   if (!self->carousel)
     return;
@@ -243,13 +448,31 @@ adw_carousel_indicator_dots_snapshot (GtkWidget   *widget,
       gtk_widget_get_direction (widget) == GTK_TEXT_DIR_RTL)
     position = points[n_points - 1] - position;
 
+  if (n_points > DOTS_MAX_VISIBLE) {
+    snapshot_dots_windowed (widget, snapshot, self->orientation, position, n_points);
+
+    g_free (points);
+
+    return;
+  }
+
   sizes = g_new0 (double, n_points);
 
   sizes[0] = points[0] + 1;
   for (i = 1; i < n_points; i++)
     sizes[i] = points[i] - points[i - 1];
 
-  snapshot_dots (widget, snapshot, self->orientation, position, sizes, n_points);
+  for (i = 0; i < n_points; i++) {
+    if (!G_APPROX_VALUE (sizes[i], 1, DBL_EPSILON)) {
+      animating = TRUE;
+      break;
+    }
+  }
+
+  if (animating)
+    snapshot_dots (widget, snapshot, self->orientation, position, sizes, n_points);
+  else
+    snapshot_dots_static (self, snapshot, position, n_points);
 
   g_free (sizes);
   g_free (points);
@@ -263,6 +486,7 @@ adw_carousel_dispose (GObject *object)
   adw_carousel_indicator_dots_set_carousel (self, NULL);
 
   g_clear_object (&self->animation);
+  g_clear_pointer (&self->static_dots, gsk_render_node_unref);
 
   G_OBJECT_CLASS (adw_carousel_indicator_dots_parent_class)->dispose (object);
 }
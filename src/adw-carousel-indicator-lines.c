@@ -19,6 +19,8 @@
 #define LINE_OPACITY 0.3
 #define LINE_OPACITY_ACTIVE 0.9
 #define LINE_MARGIN 2
+#define LINE_MIN_LENGTH 6
+#define LINES_MAX_PAGES 16
 
 /**
  * AdwCarouselIndicatorLines:
@@ -51,6 +53,13 @@ struct _AdwCarouselIndicatorLines
 
   AdwAnimation *animation;
   GBinding *duration_binding;
+
+  GskRenderNode *static_lines;
+  guint static_lines_n_pages;
+  GtkOrientation static_lines_orientation;
+  double static_lines_x;
+  double static_lines_y;
+  GdkRGBA static_lines_color;
 };
 
 G_DEFINE_FINAL_TYPE_WITH_CODE (AdwCarouselIndicatorLines, adw_carousel_indicator_lines, GTK_TYPE_WIDGET,
@@ -67,26 +76,18 @@ enum {
 
 static GParamSpec *props[LAST_PROP];
 
+/* Returns the position of the start of the first line */
 static void
-snapshot_lines (GtkWidget      *widget,
-                GtkSnapshot    *snapshot,
-                GtkOrientation  orientation,
-                double          position,
-                double         *sizes,
-                guint           n_pages)
+get_lines_origin (GtkWidget      *widget,
+                  GtkOrientation  orientation,
+                  double          indicator_length,
+                  double         *x,
+                  double         *y)
 {
-  GdkRGBA color;
-  int i, widget_length, widget_thickness;
-  double indicator_length, full_size, line_size;
-  double x = 0, y = 0, pos;
-
-  gtk_widget_get_color (widget, &color);
-  color.alpha *= LINE_OPACITY;
+  int widget_length, widget_thickness;
+  double full_size, line_size;
 
   line_size = LINE_LENGTH + LINE_SPACING;
-  indicator_length = -LINE_SPACING;
-  for (i = 0; i < n_pages; i++)
-    indicator_length += line_size * sizes[i];
 
   if (orientation == GTK_ORIENTATION_HORIZONTAL) {
     widget_length = gtk_widget_get_width (widget);
@@ -102,43 +103,150 @@ snapshot_lines (GtkWidget      *widget,
     widget_length--;
 
   if (orientation == GTK_ORIENTATION_HORIZONTAL) {
-    x = (widget_length - indicator_length) / 2.0;
-    y = (widget_thickness - LINE_WIDTH) / 2;
+    *x = (widget_length - indicator_length) / 2.0;
+    *y = (widget_thickness - LINE_WIDTH) / 2;
   } else {
-    x = (widget_thickness - LINE_WIDTH) / 2;
-    y = (widget_length - indicator_length) / 2.0;
+    *x = (widget_thickness - LINE_WIDTH) / 2;
+    *y = (widget_length - indicator_length) / 2.0;
   }
+}
+
+static inline void
+snapshot_line (GtkSnapshot    *snapshot,
+               const GdkRGBA  *color,
+               GtkOrientation  orientation,
+               double          x,
+               double          y,
+               double          offset,
+               double          length)
+{
+  if (length <= 0)
+    return;
+
+  if (orientation == GTK_ORIENTATION_HORIZONTAL)
+    gtk_snapshot_append_color (snapshot, color,
+                               &GRAPHENE_RECT_INIT (x + offset, y, length, LINE_WIDTH));
+  else
+    gtk_snapshot_append_color (snapshot, color,
+                               &GRAPHENE_RECT_INIT (x, y + offset, LINE_WIDTH, length));
+}
+
+static GskRenderNode *
+ensure_static_lines (AdwCarouselIndicatorLines *self,
+                     const GdkRGBA             *color,
+                     double                     x,
+                     double                     y,
+                     guint                      n_pages)
+{
+  GtkSnapshot *snapshot;
+  guint i;
+
+  if (self->static_lines &&
+      self->static_lines_n_pages == n_pages &&
+      self->static_lines_orientation == self->orientation &&
+      G_APPROX_VALUE (self->static_lines_x, x, DBL_EPSILON) &&
+      G_APPROX_VALUE (self->static_lines_y, y, DBL_EPSILON) &&
+      gdk_rgba_equal (&self->static_lines_color, color))
+    return self->static_lines;
+
+  g_clear_pointer (&self->static_lines, gsk_render_node_unref);
+
+  snapshot = gtk_snapshot_new ();
+
+  for (i = 0; i < n_pages; i++)
+    snapshot_line (snapshot, color, self->orientation, x, y,
+                   (LINE_LENGTH + LINE_SPACING) * i, LINE_LENGTH);
+
+  self->static_lines = gtk_snapshot_free_to_node (snapshot);
+  self->static_lines_n_pages = n_pages;
+  self->static_lines_orientation = self->orientation;
+  self->static_lines_x = x;
+  self->static_lines_y = y;
+  self->static_lines_color = *color;
+
+  return self->static_lines;
+}
+
+static void
+snapshot_lines (AdwCarouselIndicatorLines *self,
+                GtkSnapshot               *snapshot,
+                double                     position,
+                double                    *sizes,
+                guint                      n_pages)
+{
+  GtkWidget *widget = GTK_WIDGET (self);
+  GtkOrientation orientation = self->orientation;
+  GdkRGBA color;
+  int i;
+  double indicator_length, line_size;
+  double x = 0, y = 0, pos;
+  gboolean animating = FALSE;
+
+  gtk_widget_get_color (widget, &color);
+  color.alpha *= LINE_OPACITY;
 
-  pos = 0;
+  line_size = LINE_LENGTH + LINE_SPACING;
+  indicator_length = -LINE_SPACING;
   for (i = 0; i < n_pages; i++) {
-    double length;
-    graphene_rect_t rectangle;
+    indicator_length += line_size * sizes[i];
 
-    length = (LINE_LENGTH + LINE_SPACING) * sizes[i] - LINE_SPACING;
+    if (!G_APPROX_VALUE (sizes[i], 1, DBL_EPSILON))
+      animating = TRUE;
+  }
 
-    if (length > 0) {
-      if (orientation == GTK_ORIENTATION_HORIZONTAL)
-        graphene_rect_init (&rectangle, x + pos, y, length, LINE_WIDTH);
-      else
-        graphene_rect_init (&rectangle, x, y + pos, LINE_WIDTH, length);
-    }
+  get_lines_origin (widget, orientation, indicator_length, &x, &y);
 
-    gtk_snapshot_append_color (snapshot, &color, &rectangle);
+  /* The inactive lines only move while pages are added or removed */
+  if (animating) {
+    pos = 0;
+    for (i = 0; i < n_pages; i++) {
+      snapshot_line (snapshot, &color, orientation, x, y, pos,
+                     line_size * sizes[i] - LINE_SPACING);
 
-    pos += (LINE_LENGTH + LINE_SPACING) * sizes[i];
+      pos += line_size * sizes[i];
+    }
+  } else {
+    gtk_snapshot_append_node (snapshot,
+                              ensure_static_lines (self, &color, x, y, n_pages));
   }
 
   gtk_widget_get_color (widget, &color);
   color.alpha *= LINE_OPACITY_ACTIVE;
 
-  pos = position * (LINE_LENGTH + LINE_SPACING);
+  snapshot_line (snapshot, &color, orientation, x, y,
+                 position * line_size, LINE_LENGTH);
+}
 
-  if (orientation == GTK_ORIENTATION_HORIZONTAL)
-    gtk_snapshot_append_color (snapshot, &color,
-                               &GRAPHENE_RECT_INIT (x + pos, y, LINE_LENGTH, LINE_WIDTH));
-  else
-    gtk_snapshot_append_color (snapshot, &color,
-                               &GRAPHENE_RECT_INIT (x, y + pos, LINE_WIDTH, LINE_LENGTH));
+/* With too many pages to fit, draw a single track of LINES_MAX_PAGES lines
+ * instead, with the active line scaled down to match the number of pages */
+static void
+snapshot_lines_scaled (GtkWidget      *widget,
+                       GtkSnapshot    *snapshot,
+                       GtkOrientation  orientation,
+                       double          position,
+                       guint           n_pages)
+{
+  GdkRGBA color;
+  double x, y, track_length, thumb_length;
+
+  track_length = (LINE_LENGTH + LINE_SPACING) * LINES_MAX_PAGES - LINE_SPACING;
+  thumb_length = MAX (track_length / n_pages, LINE_MIN_LENGTH);
+
+  get_lines_origin (widget, orientation, track_length, &x, &y);
+
+  gtk_widget_get_color (widget, &color);
+  color.alpha *= LINE_OPACITY;
+
+  snapshot_line (snapshot, &color, orientation, x, y, 0, track_length);
+
+  gtk_widget_get_color (widget, &color);
+  color.alpha *= LINE_OPACITY_ACTIVE;
+
+  position = CLAMP (position, 0, n_pages - 1);
+
+  snapshot_line (snapshot, &color, orientation, x, y,
+                 position / (n_pages - 1) * (track_length - thumb_length),
+                 thumb_length);
 }
 
 static void
@@ -180,6 +288,8 @@ adw_carousel_indicator_lines_measure (GtkWidget      *widget,
     for (i = 0; i < n_points; i++)
       indicator_length += line_size * sizes[i];
 
+    indicator_length = MIN (indicator_length, line_size * LINES_MAX_PAGES);
+
     size = ceil (indicator_length);
 
     g_free (points);
@@ -228,13 +338,21 @@ adw_carousel_indicator_lines_snapshot (GtkWidget   *widget,
       gtk_widget_get_direction (widget) == GTK_TEXT_DIR_RTL)
     position = points[n_points - 1] - position;
 
+  if (n_points > LINES_MAX_PAGES) {
+    snapshot_lines_scaled (widget, snapshot, self->orientation, position, n_points);
+
+    g_free (points);
+
+    return;
+  }
+
   sizes = g_new0 (double, n_points);
 
   sizes[0] = points[0] + 1;
   for (i = 1; i < n_points; i++)
     sizes[i] = points[i] - points[i - 1];
 
-  snapshot_lines (widget, snapshot, self->orientation, position, sizes, n_points);
+  snapshot_lines (self, snapshot, position, sizes, n_points);
 
   g_free (sizes);
   g_free (points);
@@ -248,6 +366,7 @@ adw_carousel_dispose (GObject *object)
   adw_carousel_indicator_lines_set_carousel (self, NULL);
 
   g_clear_object (&self->animation);
+  g_clear_pointer (&self->static_lines, gsk_render_node_unref);
 
   G_OBJECT_CLASS (adw_carousel_indicator_lines_parent_class)->dispose (object);
 }
@@ -20,6 +20,8 @@
 #include <math.h>
 
 #define SCROLL_TIMEOUT_DURATION 150
+#define DEFAULT_PRELOAD_PAGES 1
+#define DEFAULT_PREPARE_RADIUS 1
 
 /**
  * AdwCarousel:
@@ -37,6 +39,15 @@
  * [class@CarouselIndicatorDots] and [class@CarouselIndicatorLines] can be used
  * to provide page indicators for `AdwCarousel`.
  *
+ * ## Models
+ *
+ * Instead of adding pages manually, `AdwCarousel` can be bound to a
+ * [iface@Gio.ListModel] with [method@Carousel.bind_model]. In that case it
+ * only creates pages for the items around the current position, as controlled
+ * by [property@Carousel:preload-pages], and recycles them as the position
+ * changes. This allows it to be used for a large number of pages, such as in a
+ * photo viewer.
+ *
  * ## CSS nodes
  *
  * `AdwCarousel` has a single CSS node with name `carousel`.
@@ -50,6 +61,7 @@ typedef struct {
   double snap_point;
   gboolean adding;
   gboolean removing;
+  gboolean prepared;
 
   gboolean shift_position;
   AdwAnimation *resize_animation;
@@ -79,6 +91,15 @@ struct _AdwCarousel
   guint scroll_timeout_id;
   gboolean can_scroll;
   gboolean is_being_allocated;
+
+  GListModel *model;
+  AdwCarouselCreatePageFunc create_page_func;
+  gpointer create_page_func_data;
+  GDestroyNotify create_page_func_data_destroy;
+  guint preload_pages;
+  GPtrArray *recycled_pages;
+
+  guint prepare_radius;
 };
 
 static void adw_carousel_buildable_init (GtkBuildableIface *iface);
@@ -102,16 +123,19 @@ enum {
   PROP_ALLOW_SCROLL_WHEEL,
   PROP_ALLOW_LONG_SWIPES,
   PROP_REVEAL_DURATION,
+  PROP_PRELOAD_PAGES,
+  PROP_PREPARE_RADIUS,
 
   /* GtkOrientable */
   PROP_ORIENTATION,
-  LAST_PROP = PROP_REVEAL_DURATION + 1,
+  LAST_PROP = PROP_PREPARE_RADIUS + 1,
 };
 
 static GParamSpec *props[LAST_PROP];
 
 enum {
   SIGNAL_PAGE_CHANGED,
+  SIGNAL_PREPARE_PAGE,
   SIGNAL_LAST_SIGNAL,
 };
 static guint signals[SIGNAL_LAST_SIGNAL];
@@ -134,8 +158,7 @@ find_child_info (AdwCarousel *self,
 
 static int
 find_child_index (AdwCarousel *self,
-                  GtkWidget   *widget,
-                  gboolean     count_removing)
+                  ChildInfo   *child)
 {
   GList *l;
   int i;
@@ -144,10 +167,10 @@ find_child_index (AdwCarousel *self,
   for (l = self->children; l; l = l->next) {
     ChildInfo *info = l->data;
 
-    if (info->removing && !count_removing)
+    if (info->removing)
       continue;
 
-    if (widget == info->widget)
+    if (info == child)
       return i;
 
     i++;
@@ -220,23 +243,243 @@ get_range (AdwCarousel *self,
     *upper = MAX (0, self->position_shift + (child ? child->snap_point : 0));
 }
 
-static GtkWidget *
+static ChildInfo *
 get_page_at_position (AdwCarousel *self,
                       double       position)
 {
   double lower = 0, upper = 0;
-  ChildInfo *child;
 
   get_range (self, &lower, &upper);
 
   position = CLAMP (position, lower, upper);
 
-  child = get_closest_child_at (self, position, TRUE, FALSE);
+  return get_closest_child_at (self, position, TRUE, FALSE);
+}
+
+static void
+update_snap_points (AdwCarousel *self)
+{
+  GList *l;
+  double snap_point;
+  gboolean snap_points_changed;
+
+  snap_point = 0;
+  snap_points_changed = FALSE;
+
+  for (l = self->children; l; l = l->next) {
+    ChildInfo *child_info = l->data;
+    double new_snap_point = snap_point + child_info->size - 1;
+
+    if (!G_APPROX_VALUE (child_info->snap_point, new_snap_point, DBL_EPSILON)) {
+      child_info->snap_point = new_snap_point;
+      snap_points_changed = TRUE;
+    }
+
+    snap_point += child_info->size;
+
+    if (child_info == self->animation_target_child)
+      adw_spring_animation_set_value_to (ADW_SPRING_ANIMATION (self->animation),
+                                         child_info->snap_point);
+  }
+
+  if (snap_points_changed)
+    adw_swipe_tracker_invalidate_snap_points (self->tracker);
+}
+
+static void
+release_model_page (AdwCarousel *self,
+                    ChildInfo   *child)
+{
+  GtkWidget *widget = child->widget;
+
+  child->widget = NULL;
+
+  if (self->recycled_pages->len < 2 * self->preload_pages + 2)
+    g_ptr_array_add (self->recycled_pages, g_object_ref (widget));
+
+  gtk_widget_unparent (widget);
+}
+
+static void
+create_model_page (AdwCarousel *self,
+                   ChildInfo   *child,
+                   guint        index,
+                   GtkWidget   *prev_sibling)
+{
+  GtkWidget *recycled = NULL, *widget;
+  gpointer item;
+
+  if (self->recycled_pages->len > 0)
+    recycled = g_ptr_array_steal_index_fast (self->recycled_pages,
+                                             self->recycled_pages->len - 1);
+
+  item = g_list_model_get_item (self->model, index);
+  widget = self->create_page_func (item, recycled, self->create_page_func_data);
+  g_object_unref (item);
+
+  if (!GTK_IS_WIDGET (widget)) {
+    g_critical ("AdwCarouselCreatePageFunc didn't return a widget for page %u, "
+                "skipping it", index);
+    g_clear_object (&recycled);
+    return;
+  }
+
+  g_object_ref_sink (widget);
+  g_clear_object (&recycled);
+
+  gtk_widget_insert_after (widget, GTK_WIDGET (self), prev_sibling);
+  child->widget = widget;
+
+  g_object_unref (widget);
+}
+
+/* Makes sure only the pages around the current position have widgets */
+static void
+update_model_pages (AdwCarousel *self)
+{
+  GtkWidget *prev_sibling = NULL;
+  double radius;
+  guint index;
+  GList *l;
+
+  if (!self->model)
+    return;
+
+  update_snap_points (self);
+
+  /* Pages that are exactly this far away are only needed once the position
+   * starts moving towards them */
+  radius = self->preload_pages + 1;
+
+  /* Release pages first so that they can be recycled right away */
+  for (l = self->children; l; l = l->next) {
+    ChildInfo *child = l->data;
+
+    if (child->widget && ABS (child->snap_point - self->position) >= radius)
+      release_model_page (self, child);
+  }
+
+  index = 0;
+  for (l = self->children; l; l = l->next) {
+    ChildInfo *child = l->data;
+
+    if (child->removing)
+      continue;
+
+    if (!child->widget && ABS (child->snap_point - self->position) < radius)
+      create_model_page (self, child, index, prev_sibling);
+
+    if (child->widget)
+      prev_sibling = child->widget;
+
+    index++;
+  }
+}
+
+typedef struct {
+  guint index;
+  double distance;
+} PreparedPage;
+
+/* Emits ::prepare-page for the pages that are now within the prepare radius of
+ * either the current position, or the position a scroll animation is going to
+ * end at */
+static void
+update_prepared_pages (AdwCarousel *self)
+{
+  g_autoptr (GArray) prepared = NULL;
+  ChildInfo *target = self->animation_target_child;
+  guint i, index;
+  GList *l;
+
+  if (!g_signal_has_handler_pending (self, signals[SIGNAL_PREPARE_PAGE], 0, FALSE))
+    return;
+
+  update_snap_points (self);
+
+  prepared = g_array_new (FALSE, FALSE, sizeof (PreparedPage));
+
+  index = 0;
+  for (l = self->children; l; l = l->next) {
+    ChildInfo *child = l->data;
+    double distance;
+    gboolean in_range;
+
+    if (child->removing)
+      continue;
+
+    distance = ABS (child->snap_point - self->position);
+
+    if (target)
+      distance = MIN (distance, ABS (child->snap_point - target->snap_point));
+
+    in_range = G_APPROX_VALUE (distance, self->prepare_radius, DBL_EPSILON) ||
+               distance < self->prepare_radius;
+
+    if (in_range && !child->prepared) {
+      PreparedPage page = { index, distance };
+
+      g_array_append_val (prepared, page);
+    }
+
+    child->prepared = in_range;
+
+    index++;
+  }
+
+  /* Handlers may change the pages, so only emit once we're done with them */
+  for (i = 0; i < prepared->len; i++) {
+    PreparedPage *page = &g_array_index (prepared, PreparedPage, i);
+
+    g_signal_emit (self, signals[SIGNAL_PREPARE_PAGE], 0, page->index, page->distance);
+  }
+}
+
+static void
+remove_all_pages (AdwCarousel *self)
+{
+  GList *l;
+
+  for (l = self->children; l; l = l->next) {
+    ChildInfo *child = l->data;
+
+    if (child->resize_animation) {
+      g_signal_handlers_disconnect_by_data (child->resize_animation, child);
+      adw_animation_reset (child->resize_animation);
+      g_clear_object (&child->resize_animation);
+    }
+
+    if (child->widget)
+      gtk_widget_unparent (child->widget);
+
+    g_free (child);
+  }
+
+  g_clear_pointer (&self->children, g_list_free);
+
+  self->animation_target_child = NULL;
+  self->position_shift = 0;
+
+  adw_swipe_tracker_invalidate_snap_points (self->tracker);
+}
+
+static void
+unbind_model (AdwCarousel *self)
+{
+  if (!self->model)
+    return;
 
-  if (!child)
-    return NULL;
+  g_signal_handlers_disconnect_by_data (self->model, self);
+  g_clear_object (&self->model);
 
-  return child->widget;
+  if (self->create_page_func_data_destroy)
+    self->create_page_func_data_destroy (self->create_page_func_data);
+
+  self->create_page_func = NULL;
+  self->create_page_func_data = NULL;
+  self->create_page_func_data_destroy = NULL;
+
+  g_ptr_array_set_size (self->recycled_pages, 0);
 }
 
 static void
@@ -279,6 +522,9 @@ set_position (AdwCarousel *self,
       update_shift_position_flag (self, child);
   }
 
+  update_model_pages (self);
+  update_prepared_pages (self);
+
   g_object_notify_by_pspec (G_OBJECT (self), props[PROP_POSITION]);
 }
 
@@ -309,10 +555,14 @@ resize_animation_done_cb (ChildInfo *child)
 
   if (child->removing) {
     self->children = g_list_remove (self->children, child);
+    adw_swipe_tracker_invalidate_snap_points (self->tracker);
 
     g_free (child);
   }
 
+  update_model_pages (self);
+  update_prepared_pages (self);
+
   gtk_widget_queue_allocate (GTK_WIDGET (self));
 }
 
@@ -350,6 +600,59 @@ animate_child_resize (AdwCarousel *self,
   adw_animation_play (child->resize_animation);
 }
 
+static void
+items_changed_cb (AdwCarousel *self,
+                  guint        position,
+                  guint        removed,
+                  guint        added)
+{
+  g_autoptr (GPtrArray) changed = g_ptr_array_sized_new (removed + added);
+  GList *link;
+  guint i;
+
+  link = get_nth_link (self, position);
+
+  /* Update the list first and only then start the animations, as they can
+   * finish right away and pages must match the model items at that point */
+  for (i = 0; i < removed; i++) {
+    ChildInfo *child = link->data;
+
+    do
+      link = link->next;
+    while (link && ((ChildInfo *) link->data)->removing);
+
+    if (child->widget)
+      release_model_page (self, child);
+
+    child->removing = TRUE;
+    g_ptr_array_add (changed, child);
+  }
+
+  for (i = 0; i < added; i++) {
+    ChildInfo *child = g_new0 (ChildInfo, 1);
+
+    child->adding = TRUE;
+    self->children = g_list_insert_before (self->children, link, child);
+    g_ptr_array_add (changed, child);
+  }
+
+  adw_swipe_tracker_invalidate_snap_points (self->tracker);
+
+  for (i = 0; i < changed->len; i++) {
+    ChildInfo *child = g_ptr_array_index (changed, i);
+
+    animate_child_resize (self, child, child->removing ? 0 : 1, self->reveal_duration);
+  }
+
+  update_model_pages (self);
+  update_prepared_pages (self);
+
+  gtk_widget_queue_allocate (GTK_WIDGET (self));
+
+  if (removed != added)
+    g_object_notify_by_pspec (G_OBJECT (self), props[PROP_N_PAGES]);
+}
+
 static void
 scroll_animation_value_cb (double       value,
                            AdwCarousel *self)
@@ -362,28 +665,31 @@ scroll_animation_value_cb (double       value,
 static void
 scroll_animation_done_cb (AdwCarousel *self)
 {
-  GtkWidget *child;
+  ChildInfo *child;
   int index;
 
   self->animation_source_position = 0;
   self->animation_target_child = NULL;
 
   child = get_page_at_position (self, self->position);
-  index = find_child_index (self, child, FALSE);
+  index = find_child_index (self, child);
 
   g_signal_emit (self, signals[SIGNAL_PAGE_CHANGED], 0, index);
 }
 
 static void
 scroll_to (AdwCarousel *self,
-           GtkWidget   *widget,
+           ChildInfo   *child,
            double       velocity)
 {
-  self->animation_target_child = find_child_info (self, widget);
+  self->animation_target_child = child;
 
   if (self->animation_target_child == NULL)
     return;
 
+  /* Let the pages around the destination start loading before we get there */
+  update_prepared_pages (self);
+
   self->animation_source_position = self->position;
 
   adw_spring_animation_set_value_from (ADW_SPRING_ANIMATION (self->animation),
@@ -428,7 +734,7 @@ end_swipe_cb (AdwSwipeTracker *tracker,
               double           to,
               AdwCarousel     *self)
 {
-  GtkWidget *child = get_page_at_position (self, to);
+  ChildInfo *child = get_page_at_position (self, to);
 
   scroll_to (self, child, velocity);
 }
@@ -482,7 +788,7 @@ scroll_cb (AdwCarousel              *self,
   int index;
   gboolean allow_vertical;
   GtkOrientation orientation;
-  GtkWidget *child;
+  ChildInfo *child;
 
   if (!self->allow_scroll_wheel)
     return GDK_EVENT_PROPAGATE;
@@ -527,10 +833,10 @@ scroll_cb (AdwCarousel              *self,
 
   child = get_page_at_position (self, self->position);
 
-  index += find_child_index (self, child, FALSE);
+  index += find_child_index (self, child);
   index = CLAMP (index, 0, (int) adw_carousel_get_n_pages (self) - 1);
 
-  scroll_to (self, adw_carousel_get_nth_page (self, index), 0);
+  scroll_to (self, get_nth_link (self, index)->data, 0);
 
   self->can_scroll = FALSE;
   self->scroll_timeout_id =
@@ -568,7 +874,7 @@ adw_carousel_measure (GtkWidget      *widget,
     GtkWidget *child = child_info->widget;
     int child_min, child_nat;
 
-    if (child_info->removing)
+    if (child_info->removing || !child)
       continue;
 
     if (!gtk_widget_get_visible (child))
@@ -595,7 +901,6 @@ adw_carousel_size_allocate (GtkWidget *widget,
   GList *children;
   double x, y, offset;
   gboolean is_rtl;
-  double snap_point;
 
   if (!G_APPROX_VALUE (self->position_shift, 0, DBL_EPSILON)) {
     set_position (self, self->position + self->position_shift);
@@ -610,7 +915,7 @@ adw_carousel_size_allocate (GtkWidget *widget,
     int min, nat;
     int child_size;
 
-    if (child_info->removing)
+    if (child_info->removing || !child)
       continue;
 
     if (self->orientation == GTK_ORIENTATION_HORIZONTAL) {
@@ -642,19 +947,7 @@ adw_carousel_size_allocate (GtkWidget *widget,
     child_height = size;
   }
 
-  snap_point = 0;
-
-  for (children = self->children; children; children = children->next) {
-    ChildInfo *child_info = children->data;
-
-    child_info->snap_point = snap_point + child_info->size - 1;
-
-    snap_point += child_info->size;
-
-    if (child_info == self->animation_target_child)
-      adw_spring_animation_set_value_to (ADW_SPRING_ANIMATION (self->animation),
-                                         child_info->snap_point);
-  }
+  update_snap_points (self);
 
   x = 0;
   y = 0;
@@ -677,7 +970,7 @@ adw_carousel_size_allocate (GtkWidget *widget,
     ChildInfo *child_info = children->data;
     GskTransform *transform = gsk_transform_new ();
 
-    if (!child_info->removing) {
+    if (!child_info->removing && child_info->widget) {
       if (!gtk_widget_get_visible (child_info->widget))
         continue;
 
@@ -733,6 +1026,13 @@ adw_carousel_dispose (GObject *object)
 {
   AdwCarousel *self = ADW_CAROUSEL (object);
 
+  if (self->model) {
+    unbind_model (self);
+    remove_all_pages (self);
+  }
+
+  g_clear_pointer (&self->recycled_pages, g_ptr_array_unref);
+
   while (self->children) {
     ChildInfo *info = self->children->data;
 
@@ -797,6 +1097,14 @@ adw_carousel_get_property (GObject    *object,
     g_value_set_uint (value, adw_carousel_get_reveal_duration (self));
     break;
 
+  case PROP_PRELOAD_PAGES:
+    g_value_set_uint (value, adw_carousel_get_preload_pages (self));
+    break;
+
+  case PROP_PREPARE_RADIUS:
+    g_value_set_uint (value, adw_carousel_get_prepare_radius (self));
+    break;
+
   case PROP_ORIENTATION:
     g_value_set_enum (value, self->orientation);
     break;
@@ -835,6 +1143,14 @@ adw_carousel_set_property (GObject      *object,
     adw_carousel_set_reveal_duration (self, g_value_get_uint (value));
     break;
 
+  case PROP_PRELOAD_PAGES:
+    adw_carousel_set_preload_pages (self, g_value_get_uint (value));
+    break;
+
+  case PROP_PREPARE_RADIUS:
+    adw_carousel_set_prepare_radius (self, g_value_get_uint (value));
+    break;
+
   case PROP_ALLOW_MOUSE_DRAG:
     adw_carousel_set_allow_mouse_drag (self, g_value_get_boolean (value));
     break;
@@ -999,6 +1315,39 @@ adw_carousel_class_init (AdwCarouselClass *klass)
                        0,
                        G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS | G_PARAM_EXPLICIT_NOTIFY);
 
+  /**
+   * AdwCarousel:preload-pages: (attributes org.gtk.Property.get=adw_carousel_get_preload_pages org.gtk.Property.set=adw_carousel_set_preload_pages)
+   *
+   * The number of pages to create on each side of the current page.
+   *
+   * Only used when the carousel is bound to a model with
+   * [method@Carousel.bind_model]. Pages further away from the current position
+   * don't have widgets, and their widgets are recycled for other pages.
+   *
+   * Since: 1.5
+   */
+  props[PROP_PRELOAD_PAGES] =
+    g_param_spec_uint ("preload-pages", NULL, NULL,
+                       0,
+                       G_MAXUINT,
+                       DEFAULT_PRELOAD_PAGES,
+                       G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS | G_PARAM_EXPLICIT_NOTIFY);
+
+  /**
+   * AdwCarousel:prepare-radius: (attributes org.gtk.Property.get=adw_carousel_get_prepare_radius org.gtk.Property.set=adw_carousel_set_prepare_radius)
+   *
+   * How close to the current position a page must be, in pages, for
+   * [signal@Carousel::prepare-page] to be emitted for it.
+   *
+   * Since: 1.5
+   */
+  props[PROP_PREPARE_RADIUS] =
+    g_param_spec_uint ("prepare-radius", NULL, NULL,
+                       0,
+                       G_MAXUINT,
+                       DEFAULT_PREPARE_RADIUS,
+                       G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS | G_PARAM_EXPLICIT_NOTIFY);
+
   g_object_class_override_property (object_class,
                                     PROP_ORIENTATION,
                                     "orientation");
@@ -1032,6 +1381,42 @@ adw_carousel_class_init (AdwCarouselClass *klass)
                               G_TYPE_FROM_CLASS (klass),
                               adw_marshal_VOID__UINTv);
 
+  /**
+   * AdwCarousel::prepare-page:
+   * @self: a carousel
+   * @index: the page that is about to be shown
+   * @distance: how far the page is, in pages
+   *
+   * This signal is emitted when a page comes within
+   * [property@Carousel:prepare-radius] of the current position.
+   *
+   * When the carousel is scrolling towards a page, including after a swipe,
+   * the pages around the destination are prepared as soon as the scroll
+   * starts, and @distance is measured from the destination instead.
+   *
+   * It can be used to start loading expensive content, such as images, before
+   * the page becomes visible. Closer pages should be loaded first.
+   *
+   * The signal is emitted again if the page moves out of the radius and then
+   * back into it.
+   *
+   * Since: 1.5
+   */
+  signals[SIGNAL_PREPARE_PAGE] =
+    g_signal_new ("prepare-page",
+                  G_TYPE_FROM_CLASS (klass),
+                  G_SIGNAL_RUN_LAST,
+                  0,
+                  NULL, NULL,
+                  adw_marshal_VOID__UINT_DOUBLE,
+                  G_TYPE_NONE,
+                  2,
+                  G_TYPE_UINT,
+                  G_TYPE_DOUBLE);
+  g_signal_set_va_marshaller (signals[SIGNAL_PREPARE_PAGE],
+                              G_TYPE_FROM_CLASS (klass),
+                              adw_marshal_VOID__UINT_DOUBLEv);
+
   gtk_widget_class_set_css_name (widget_class, "carousel");
 }
 
@@ -1048,6 +1433,9 @@ adw_carousel_init (AdwCarousel *self)
   self->orientation = GTK_ORIENTATION_HORIZONTAL;
   self->reveal_duration = 0;
   self->can_scroll = TRUE;
+  self->preload_pages = DEFAULT_PRELOAD_PAGES;
+  self->prepare_radius = DEFAULT_PREPARE_RADIUS;
+  self->recycled_pages = g_ptr_array_new_with_free_func (g_object_unref);
 
   self->tracker = adw_swipe_tracker_new (ADW_SWIPEABLE (self));
   adw_swipe_tracker_set_allow_mouse_drag (self->tracker, TRUE);
@@ -1223,6 +1611,7 @@ adw_carousel_insert (AdwCarousel *self,
   g_return_if_fail (GTK_IS_WIDGET (widget));
   g_return_if_fail (gtk_widget_get_parent (widget) == NULL);
   g_return_if_fail (position >= -1);
+  g_return_if_fail (self->model == NULL);
 
   info = g_new0 (ChildInfo, 1);
   info->widget = widget;
@@ -1233,6 +1622,7 @@ adw_carousel_insert (AdwCarousel *self,
     next_link = get_nth_link (self, position);
 
   self->children = g_list_insert_before (self->children, next_link, info);
+  adw_swipe_tracker_invalidate_snap_points (self->tracker);
 
   if (next_link) {
     ChildInfo *next_sibling = next_link->data;
@@ -1273,6 +1663,7 @@ adw_carousel_reorder (AdwCarousel *self,
   g_return_if_fail (ADW_IS_CAROUSEL (self));
   g_return_if_fail (GTK_IS_WIDGET (child));
   g_return_if_fail (position >= -1);
+  g_return_if_fail (self->model == NULL);
 
   closest_point = get_closest_snap_point (self);
 
@@ -1329,6 +1720,8 @@ adw_carousel_reorder (AdwCarousel *self,
     gtk_widget_insert_before (child, GTK_WIDGET (self), NULL);
   }
 
+  adw_swipe_tracker_invalidate_snap_points (self->tracker);
+
   if (G_APPROX_VALUE (closest_point, old_point, DBL_EPSILON))
     self->position_shift += new_point - old_point;
   else if ((G_APPROX_VALUE (old_point, closest_point, DBL_EPSILON) || old_point > closest_point) &&
@@ -1358,6 +1751,7 @@ adw_carousel_remove (AdwCarousel *self,
   g_return_if_fail (ADW_IS_CAROUSEL (self));
   g_return_if_fail (GTK_IS_WIDGET (child));
   g_return_if_fail (gtk_widget_get_parent (child) == GTK_WIDGET (self));
+  g_return_if_fail (self->model == NULL);
 
   info = find_child_info (self, child);
 
@@ -1380,7 +1774,7 @@ do_scroll_to (AdwCarousel *self,
               GtkWidget   *widget,
               gboolean     animate)
 {
-  scroll_to (self, widget, 0);
+  scroll_to (self, find_child_info (self, widget), 0);
 
   if (!animate)
     adw_animation_skip (self->animation);
@@ -1441,6 +1835,39 @@ adw_carousel_scroll_to (AdwCarousel *self,
   do_scroll_to (self, widget, animate);
 }
 
+/**
+ * adw_carousel_scroll_to_nth_page:
+ * @self: a carousel
+ * @n: index of the page
+ * @animate: whether to animate the transition
+ *
+ * Scrolls to the page at position @n.
+ *
+ * Unlike [method@Carousel.scroll_to], this works for pages that don't
+ * currently have a widget when @self is bound to a model.
+ *
+ * If @animate is `TRUE`, the transition will be animated.
+ *
+ * Since: 1.5
+ */
+void
+adw_carousel_scroll_to_nth_page (AdwCarousel *self,
+                                 guint        n,
+                                 gboolean     animate)
+{
+  g_return_if_fail (ADW_IS_CAROUSEL (self));
+  g_return_if_fail (n < adw_carousel_get_n_pages (self));
+
+  /* Snap points are normally only updated on allocation, so make sure the
+   * target is in place */
+  update_snap_points (self);
+
+  scroll_to (self, get_nth_link (self, n)->data, 0);
+
+  if (!animate)
+    adw_animation_skip (self->animation);
+}
+
 /**
  * adw_carousel_get_nth_page:
  * @self: a carousel
@@ -1448,7 +1875,10 @@ adw_carousel_scroll_to (AdwCarousel *self,
  *
  * Gets the page at position @n.
  *
- * Returns: (transfer none): the page
+ * If @self is bound to a model, only the pages around the current position
+ * exist, see [property@Carousel:preload-pages].
+ *
+ * Returns: (transfer none) (nullable): the page
  */
 GtkWidget *
 adw_carousel_get_nth_page (AdwCarousel *self,
@@ -1795,3 +2225,187 @@ adw_carousel_set_reveal_duration (AdwCarousel *self,
 
   g_object_notify_by_pspec (G_OBJECT (self), props[PROP_REVEAL_DURATION]);
 }
+
+/**
+ * AdwCarouselCreatePageFunc:
+ * @item: (type GObject): the item from the model to create a page for
+ * @recycled: (nullable): a page that is no longer used, or `NULL`
+ * @user_data: (closure): user data
+ *
+ * Called for carousels bound to a model to create a page for @item.
+ *
+ * If @recycled is not `NULL`, it was previously returned by this function for
+ * a different item, and it can be updated for @item and returned instead of
+ * creating a new widget.
+ *
+ * Returns: (transfer none): a page for @item
+ *
+ * Since: 1.5
+ */
+
+/**
+ * adw_carousel_bind_model:
+ * @self: a carousel
+ * @model: (nullable): the model to be bound to @self
+ * @create_page_func: (nullable) (scope notified) (closure user_data) (destroy user_data_free_func): a function that creates pages for items
+ * @user_data: user data passed to @create_page_func
+ * @user_data_free_func: function for freeing @user_data
+ *
+ * Binds @model to @self.
+ *
+ * If @self was already bound to a model, that previous binding is destroyed.
+ *
+ * The pages of @self are replaced with one page for each item in @model, and
+ * the carousel scrolls to the first page. Pages are created with
+ * @create_page_func, but only for the items around the current position, as
+ * controlled by [property@Carousel:preload-pages]. When the position changes,
+ * pages that are no longer needed are recycled.
+ *
+ * Pages added or removed in @model are animated according to
+ * [property@Carousel:reveal-duration].
+ *
+ * Note that using a model is incompatible with adding pages manually, so
+ * [method@Carousel.insert], [method@Carousel.reorder] and
+ * [method@Carousel.remove] can't be used while @self is bound to a model.
+ *
+ * If @model is `NULL`, @self is left empty.
+ *
+ * Since: 1.5
+ */
+void
+adw_carousel_bind_model (AdwCarousel               *self,
+                         GListModel                *model,
+                         AdwCarouselCreatePageFunc  create_page_func,
+                         gpointer                   user_data,
+                         GDestroyNotify             user_data_free_func)
+{
+  guint i, n_items;
+
+  g_return_if_fail (ADW_IS_CAROUSEL (self));
+  g_return_if_fail (model == NULL || G_IS_LIST_MODEL (model));
+  g_return_if_fail (model == NULL || create_page_func != NULL);
+
+  adw_animation_reset (self->animation);
+
+  unbind_model (self);
+  remove_all_pages (self);
+
+  if (model) {
+    self->model = g_object_ref (model);
+    self->create_page_func = create_page_func;
+    self->create_page_func_data = user_data;
+    self->create_page_func_data_destroy = user_data_free_func;
+
+    g_signal_connect_swapped (model, "items-changed",
+                              G_CALLBACK (items_changed_cb), self);
+
+    /* All pages are the same, so there's no need to animate them in */
+    n_items = g_list_model_get_n_items (model);
+
+    for (i = 0; i < n_items; i++) {
+      ChildInfo *info = g_new0 (ChildInfo, 1);
+
+      info->size = 1;
+
+      self->children = g_list_prepend (self->children, info);
+    }
+  }
+
+  set_position (self, 0);
+
+  gtk_widget_queue_resize (GTK_WIDGET (self));
+
+  g_object_notify_by_pspec (G_OBJECT (self), props[PROP_N_PAGES]);
+}
+
+/**
+ * adw_carousel_get_preload_pages: (attributes org.gtk.Method.get_property=preload-pages)
+ * @self: a carousel
+ *
+ * Gets the number of pages to create on each side of the current page.
+ *
+ * Returns: the number of pages to create on each side of the current page
+ *
+ * Since: 1.5
+ */
+guint
+adw_carousel_get_preload_pages (AdwCarousel *self)
+{
+  g_return_val_if_fail (ADW_IS_CAROUSEL (self), 0);
+
+  return self->preload_pages;
+}
+
+/**
+ * adw_carousel_set_preload_pages: (attributes org.gtk.Method.set_property=preload-pages)
+ * @self: a carousel
+ * @preload_pages: the number of pages to create on each side of the current page
+ *
+ * Sets the number of pages to create on each side of the current page.
+ *
+ * Only used when @self is bound to a model with [method@Carousel.bind_model].
+ * Pages further away from the current position don't have widgets, and their
+ * widgets are recycled for other pages.
+ *
+ * Since: 1.5
+ */
+void
+adw_carousel_set_preload_pages (AdwCarousel *self,
+                                guint        preload_pages)
+{
+  g_return_if_fail (ADW_IS_CAROUSEL (self));
+
+  if (self->preload_pages == preload_pages)
+    return;
+
+  self->preload_pages = preload_pages;
+
+  update_model_pages (self);
+
+  g_object_notify_by_pspec (G_OBJECT (self), props[PROP_PRELOAD_PAGES]);
+}
+
+/**
+ * adw_carousel_get_prepare_radius: (attributes org.gtk.Method.get_property=prepare-radius)
+ * @self: a carousel
+ *
+ * Gets how close to the current position a page must be to be prepared.
+ *
+ * Returns: the prepare radius, in pages
+ *
+ * Since: 1.5
+ */
+guint
+adw_carousel_get_prepare_radius (AdwCarousel *self)
+{
+  g_return_val_if_fail (ADW_IS_CAROUSEL (self), 0);
+
+  return self->prepare_radius;
+}
+
+/**
+ * adw_carousel_set_prepare_radius: (attributes org.gtk.Method.set_property=prepare-radius)
+ * @self: a carousel
+ * @prepare_radius: the prepare radius, in pages
+ *
+ * Sets how close to the current position a page must be to be prepared.
+ *
+ * See [signal@Carousel::prepare-page].
+ *
+ * Since: 1.5
+ */
+void
+adw_carousel_set_prepare_radius (AdwCarousel *self,
+                                 guint        prepare_radius)
+{
+  g_return_if_fail (ADW_IS_CAROUSEL (self));
+
+  if (self->prepare_radius == prepare_radius)
+    return;
+
+  self->prepare_radius = prepare_radius;
+
+  update_prepared_pages (self);
+
+  g_object_notify_by_pspec (G_OBJECT (self), props[PROP_PREPARE_RADIUS]);
+}
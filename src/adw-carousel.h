@@ -23,6 +23,10 @@ G_BEGIN_DECLS
 ADW_AVAILABLE_IN_ALL
 G_DECLARE_FINAL_TYPE (AdwCarousel, adw_carousel, ADW, CAROUSEL, GtkWidget)
 
+typedef GtkWidget *(*AdwCarouselCreatePageFunc) (gpointer   item,
+                                                 GtkWidget *recycled,
+                                                 gpointer   user_data);
+
 ADW_AVAILABLE_IN_ALL
 GtkWidget *adw_carousel_new (void) G_GNUC_WARN_UNUSED_RESULT;
 
@@ -50,6 +54,17 @@ ADW_AVAILABLE_IN_ALL
 void adw_carousel_scroll_to (AdwCarousel *self,
                              GtkWidget   *widget,
                              gboolean     animate);
+ADW_AVAILABLE_IN_1_5
+void adw_carousel_scroll_to_nth_page (AdwCarousel *self,
+                                      guint        n,
+                                      gboolean     animate);
+
+ADW_AVAILABLE_IN_1_5
+void adw_carousel_bind_model (AdwCarousel               *self,
+                              GListModel                *model,
+                              AdwCarouselCreatePageFunc  create_page_func,
+                              gpointer                   user_data,
+                              GDestroyNotify             user_data_free_func);
 
 ADW_AVAILABLE_IN_ALL
 GtkWidget *adw_carousel_get_nth_page (AdwCarousel *self,
@@ -100,4 +115,16 @@ guint adw_carousel_get_reveal_duration (AdwCarousel *self);
 ADW_AVAILABLE_IN_ALL
 void  adw_carousel_set_reveal_duration (AdwCarousel *self,
                                         guint        reveal_duration);
+
+ADW_AVAILABLE_IN_1_5
+guint adw_carousel_get_preload_pages (AdwCarousel *self);
+ADW_AVAILABLE_IN_1_5
+void  adw_carousel_set_preload_pages (AdwCarousel *self,
+                                      guint        preload_pages);
+
+ADW_AVAILABLE_IN_1_5
+guint adw_carousel_get_prepare_radius (AdwCarousel *self);
+ADW_AVAILABLE_IN_1_5
+void  adw_carousel_set_prepare_radius (AdwCarousel *self,
+                                       guint        prepare_radius);
 G_END_DECLS
@@ -15,12 +15,13 @@ struct _AdwGizmo
 {
   GtkWidget parent_instance;
 
-  AdwGizmoMeasureFunc   measure_func;
-  AdwGizmoAllocateFunc  allocate_func;
-  AdwGizmoSnapshotFunc  snapshot_func;
-  AdwGizmoContainsFunc  contains_func;
-  AdwGizmoFocusFunc     focus_func;
-  AdwGizmoGrabFocusFunc grab_focus_func;
+  AdwGizmoMeasureFunc    measure_func;
+  AdwGizmoAllocateFunc   allocate_func;
+  AdwGizmoSnapshotFunc   snapshot_func;
+  AdwGizmoContainsFunc   contains_func;
+  AdwGizmoFocusFunc      focus_func;
+  AdwGizmoGrabFocusFunc  grab_focus_func;
+  AdwGizmoCssChangedFunc css_changed_func;
 };
 
 G_DEFINE_FINAL_TYPE (AdwGizmo, adw_gizmo, GTK_TYPE_WIDGET)
@@ -102,6 +103,18 @@ adw_gizmo_grab_focus (GtkWidget *widget)
   return FALSE;
 }
 
+static void
+adw_gizmo_css_changed (GtkWidget         *widget,
+                       GtkCssStyleChange *change)
+{
+  AdwGizmo *self = ADW_GIZMO (widget);
+
+  GTK_WIDGET_CLASS (adw_gizmo_parent_class)->css_changed (widget, change);
+
+  if (self->css_changed_func)
+    self->css_changed_func (self);
+}
+
 static void
 adw_gizmo_dispose (GObject *object)
 {
@@ -133,6 +146,7 @@ adw_gizmo_class_init (AdwGizmoClass *klass)
   widget_class->contains = adw_gizmo_contains;
   widget_class->grab_focus = adw_gizmo_grab_focus;
   widget_class->focus = adw_gizmo_focus;
+  widget_class->css_changed = adw_gizmo_css_changed;
   widget_class->compute_expand = adw_widget_compute_expand;
 }
 
@@ -238,3 +252,10 @@ adw_gizmo_set_grab_focus_func (AdwGizmo              *self,
 {
   self->grab_focus_func = grab_focus_func;
 }
+
+void
+adw_gizmo_set_css_changed_func (AdwGizmo               *self,
+                                AdwGizmoCssChangedFunc  css_changed_func)
+{
+  self->css_changed_func = css_changed_func;
+}
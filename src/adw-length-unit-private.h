@@ -0,0 +1,19 @@
+/*
+ * Copyright (C) 2024 GNOME Foundation, Inc.
+ *
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#pragma once
+
+#if !defined(_ADVAITA_INSIDE) && !defined(ADVAITA_COMPILATION)
+#error "Only <advaita.h> can be included directly."
+#endif
+
+#include "adw-length-unit.h"
+
+G_BEGIN_DECLS
+
+double adw_length_unit_get_dpi (GtkSettings *settings);
+
+G_END_DECLS
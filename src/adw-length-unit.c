@@ -8,7 +8,7 @@
 
 #include "config.h"
 
-#include "adw-length-unit.h"
+#include "adw-length-unit-private.h"
 
 /**
  * AdwLengthUnit:
@@ -29,8 +29,16 @@
  * Since: 1.4
  */
 
-static double
-get_dpi (GtkSettings *settings)
+typedef struct {
+  double dpi;
+} DpiCache;
+
+static GQuark dpi_cache_quark;
+
+static void
+update_dpi (GtkSettings *settings,
+            GParamSpec  *pspec,
+            DpiCache    *cache)
 {
   int xft_dpi;
 
@@ -39,7 +47,54 @@ get_dpi (GtkSettings *settings)
   if (xft_dpi == 0)
     xft_dpi = 96 * PANGO_SCALE;
 
-  return xft_dpi / PANGO_SCALE;
+  cache->dpi = xft_dpi / PANGO_SCALE;
+}
+
+/*
+ * Reading gtk-xft-dpi goes through g_object_get(), which is too slow to do on
+ * every measure() and size_allocate() call. Instead, cache it on the settings
+ * object and only update it when it changes.
+ */
+double
+adw_length_unit_get_dpi (GtkSettings *settings)
+{
+  DpiCache *cache;
+
+  if (G_UNLIKELY (!dpi_cache_quark))
+    dpi_cache_quark = g_quark_from_static_string ("-adw-length-unit-dpi-cache");
+
+  cache = g_object_get_qdata (G_OBJECT (settings), dpi_cache_quark);
+
+  if (G_LIKELY (cache))
+    return cache->dpi;
+
+  cache = g_new0 (DpiCache, 1);
+
+  g_object_set_qdata_full (G_OBJECT (settings), dpi_cache_quark,
+                           cache, g_free);
+
+  g_signal_connect (settings, "notify::gtk-xft-dpi",
+                    G_CALLBACK (update_dpi), cache);
+
+  update_dpi (settings, NULL, cache);
+
+  return cache->dpi;
+}
+
+static inline double
+get_to_px_factor (AdwLengthUnit  unit,
+                  GtkSettings   *settings)
+{
+  switch (unit) {
+  case ADW_LENGTH_UNIT_PX:
+    return 1;
+  case ADW_LENGTH_UNIT_PT:
+    return adw_length_unit_get_dpi (settings) / 72.0;
+  case ADW_LENGTH_UNIT_SP:
+    return adw_length_unit_get_dpi (settings) / 96.0;
+  default:
+    g_assert_not_reached ();
+  }
 }
 
 /**
@@ -69,16 +124,10 @@ adw_length_unit_to_px (AdwLengthUnit  unit,
   if (!settings)
     return 0;
 
-  switch (unit) {
-  case ADW_LENGTH_UNIT_PX:
+  if (unit == ADW_LENGTH_UNIT_PX)
     return value;
-  case ADW_LENGTH_UNIT_PT:
-    return value * get_dpi (settings) / 72.0;
-  case ADW_LENGTH_UNIT_SP:
-    return value * get_dpi (settings) / 96.0;
-  default:
-    g_assert_not_reached ();
-  }
+
+  return value * get_to_px_factor (unit, settings);
 }
 
 /**
@@ -108,14 +157,108 @@ adw_length_unit_from_px (AdwLengthUnit  unit,
   if (!settings)
     return 0;
 
-  switch (unit) {
-  case ADW_LENGTH_UNIT_PX:
+  if (unit == ADW_LENGTH_UNIT_PX)
     return value;
-  case ADW_LENGTH_UNIT_PT:
-    return value / get_dpi (settings) * 72.0;
-  case ADW_LENGTH_UNIT_SP:
-    return value / get_dpi (settings) * 96.0;
-  default:
-    g_assert_not_reached ();
+
+  return value / get_to_px_factor (unit, settings);
+}
+
+/**
+ * adw_length_unit_to_px_array:
+ * @unit: a length unit
+ * @values: (array length=n_values): values in @unit
+ * @n_values: the number of elements in @values and @px_values
+ * @px_values: (array length=n_values) (out caller-allocates): return location
+ *   for the values in pixels
+ * @settings: (nullable): settings to use, or `NULL` for default settings
+ *
+ * Converts each element of @values from @unit to pixels.
+ *
+ * This is equivalent to calling [func@LengthUnit.to_px] for each element, but
+ * only looks up @settings once.
+ *
+ * @values and @px_values can point to the same array.
+ *
+ * Since: 1.5
+ */
+void
+adw_length_unit_to_px_array (AdwLengthUnit  unit,
+                             const double  *values,
+                             gsize          n_values,
+                             double        *px_values,
+                             GtkSettings   *settings)
+{
+  double factor;
+  gsize i;
+
+  g_return_if_fail (unit >= ADW_LENGTH_UNIT_PX);
+  g_return_if_fail (unit <= ADW_LENGTH_UNIT_SP);
+  g_return_if_fail (values != NULL || n_values == 0);
+  g_return_if_fail (px_values != NULL || n_values == 0);
+  g_return_if_fail (settings == NULL || GTK_IS_SETTINGS (settings));
+
+  if (!settings)
+    settings = gtk_settings_get_default ();
+
+  if (!settings) {
+    for (i = 0; i < n_values; i++)
+      px_values[i] = 0;
+
+    return;
+  }
+
+  factor = get_to_px_factor (unit, settings);
+
+  for (i = 0; i < n_values; i++)
+    px_values[i] = values[i] * factor;
+}
+
+/**
+ * adw_length_unit_from_px_array:
+ * @unit: a length unit
+ * @px_values: (array length=n_values): values in pixels
+ * @n_values: the number of elements in @px_values and @values
+ * @values: (array length=n_values) (out caller-allocates): return location for
+ *   the values in @unit
+ * @settings: (nullable): settings to use, or `NULL` for default settings
+ *
+ * Converts each element of @px_values from pixels to @unit.
+ *
+ * This is equivalent to calling [func@LengthUnit.from_px] for each element,
+ * but only looks up @settings once.
+ *
+ * @px_values and @values can point to the same array.
+ *
+ * Since: 1.5
+ */
+void
+adw_length_unit_from_px_array (AdwLengthUnit  unit,
+                               const double  *px_values,
+                               gsize          n_values,
+                               double        *values,
+                               GtkSettings   *settings)
+{
+  double factor;
+  gsize i;
+
+  g_return_if_fail (unit >= ADW_LENGTH_UNIT_PX);
+  g_return_if_fail (unit <= ADW_LENGTH_UNIT_SP);
+  g_return_if_fail (px_values != NULL || n_values == 0);
+  g_return_if_fail (values != NULL || n_values == 0);
+  g_return_if_fail (settings == NULL || GTK_IS_SETTINGS (settings));
+
+  if (!settings)
+    settings = gtk_settings_get_default ();
+
+  if (!settings) {
+    for (i = 0; i < n_values; i++)
+      values[i] = 0;
+
+    return;
   }
+
+  factor = get_to_px_factor (unit, settings);
+
+  for (i = 0; i < n_values; i++)
+    values[i] = px_values[i] / factor;
 }
@@ -33,4 +33,18 @@ ADW_AVAILABLE_IN_1_4
 double adw_length_unit_from_px (AdwLengthUnit  unit,
                                 double         value,
                                 GtkSettings   *settings);
+
+ADW_AVAILABLE_IN_1_5
+void adw_length_unit_to_px_array   (AdwLengthUnit  unit,
+                                    const double  *values,
+                                    gsize          n_values,
+                                    double        *px_values,
+                                    GtkSettings   *settings);
+ADW_AVAILABLE_IN_1_5
+void adw_length_unit_from_px_array (AdwLengthUnit  unit,
+                                    const double  *px_values,
+                                    gsize          n_values,
+                                    double        *values,
+                                    GtkSettings   *settings);
+
 G_END_DECLS
@@ -17,7 +17,11 @@ G_BEGIN_DECLS
  * discoverable, for example so they can easily be used with GtkBuilder.
  *
  * The function is implemented in adw-public-types.c which is generated at
- * compile time by gen-public-types.sh
+ * compile time by gen-public-types.py
+ *
+ * With the lazy-public-types build option, types that GtkBuilderCScope can
+ * find by name through their get_type() function are skipped, and only get
+ * registered when first used.
  */
 void adw_init_public_types (void);
 
@@ -8,12 +8,27 @@
 #include "adw-main-private.h"
 
 #include "adw-inspector-page-private.h"
+#include "adw-profiler-private.h"
 #include "adw-style-manager-private.h"
 #include <glib/gi18n-lib.h>
 #include <gtk/gtk.h>
 
 static int adw_initialized = FALSE;
 
+/* Reports the time spent in a phase of adw_init() as a sysprof mark, and
+ * prints it when ADW_DEBUG=startup is set */
+static void
+end_startup_phase (gint64      begin_time,
+                   const char *phase)
+{
+  gint64 duration = adw_profiler_get_current_time () - begin_time;
+
+  adw_profiler_add_mark (begin_time, duration, "adw_init", phase);
+
+  if (ADW_DEBUG_CHECK (STARTUP))
+    g_printerr ("adw_init: %s: %.3f ms\n", phase, duration / 1000000.0);
+}
+
 /**
  * adw_init:
  *
@@ -32,28 +47,49 @@ static int adw_initialized = FALSE;
 void
 adw_init (void)
 {
+  gint64 init_start, phase_start;
+
   if (adw_initialized)
     return;
 
+  init_start = phase_start = adw_profiler_get_current_time ();
+
   gtk_init ();
 
+  end_startup_phase (phase_start, "gtk_init");
+  phase_start = adw_profiler_get_current_time ();
+
   bind_textdomain_codeset (GETTEXT_PACKAGE, "UTF-8");
   bindtextdomain (GETTEXT_PACKAGE, LOCALEDIR);
   adw_init_public_types ();
 
+  end_startup_phase (phase_start, "types");
+
   if (!adw_is_granite_present ()) {
+    phase_start = adw_profiler_get_current_time ();
+
     gtk_icon_theme_add_resource_path (gtk_icon_theme_get_for_display (gdk_display_get_default ()),
                                       "/org/gnome/Advaita/icons");
 
+    end_startup_phase (phase_start, "icons");
+    phase_start = adw_profiler_get_current_time ();
+
     adw_style_manager_ensure ();
 
+    end_startup_phase (phase_start, "style manager");
+    phase_start = adw_profiler_get_current_time ();
+
     if (g_io_extension_point_lookup ("gtk-inspector-page"))
       g_io_extension_point_implement ("gtk-inspector-page",
                                       ADW_TYPE_INSPECTOR_PAGE,
                                       "libadvaita",
                                       10);
+
+    end_startup_phase (phase_start, "inspector");
   }
 
+  end_startup_phase (init_start, "total");
+
   adw_initialized = TRUE;
 }
 
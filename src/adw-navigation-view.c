@@ -222,8 +222,13 @@ typedef struct
   gboolean can_pop;
 
   GtkWidget *last_focus;
+  GArray *last_focus_path;
   gboolean remove_on_pop;
 
+  AdwNavigationPageChildFunc child_func;
+  gpointer child_func_data;
+  GDestroyNotify child_func_data_destroy;
+
   int block_signals;
 
   AdwNavigationView *child_view;
@@ -269,6 +274,8 @@ struct _AdwNavigationView
 
   gboolean animate_transitions;
   gboolean pop_on_escape;
+  gboolean cache_transitions;
+  int retention_depth;
 
   AdwAnimation *transition;
   AdwNavigationPage *showing_page;
@@ -277,6 +284,7 @@ struct _AdwNavigationView
   gboolean transition_cancel;
   double transition_progress;
   gboolean gesture_active;
+  GdkTexture *transition_texture;
 
   AdwShadowHelper *shadow_helper;
   AdwSwipeTracker *swipe_tracker;
@@ -299,6 +307,8 @@ enum {
   PROP_ANIMATE_TRANSITIONS,
   PROP_POP_ON_ESCAPE,
   PROP_NAVIGATION_STACK,
+  PROP_CACHE_TRANSITIONS,
+  PROP_RETENTION_DEPTH,
   LAST_PROP
 };
 
@@ -397,6 +407,112 @@ set_remove_on_pop (AdwNavigationPage *self,
   priv->remove_on_pop = remove_on_pop;
 }
 
+static void
+set_last_focus (AdwNavigationPage *self,
+                GtkWidget         *focus)
+{
+  AdwNavigationPagePrivate *priv = adw_navigation_page_get_instance_private (self);
+
+  if (priv->last_focus)
+    g_object_remove_weak_pointer (G_OBJECT (priv->last_focus),
+                                  (gpointer *)&priv->last_focus);
+  priv->last_focus = focus;
+  if (priv->last_focus)
+    g_object_add_weak_pointer (G_OBJECT (priv->last_focus),
+                               (gpointer *)&priv->last_focus);
+}
+
+/* Remembers where the focus widget was by its child index at every level, so
+ * that it can be found again in a recreated child */
+static GArray *
+get_focus_path (GtkWidget *page,
+                GtkWidget *widget)
+{
+  GArray *path = g_array_new (FALSE, FALSE, sizeof (guint));
+
+  while (widget && widget != page) {
+    GtkWidget *parent = gtk_widget_get_parent (widget);
+    GtkWidget *sibling;
+    guint index = 0;
+
+    for (sibling = gtk_widget_get_prev_sibling (widget);
+         sibling;
+         sibling = gtk_widget_get_prev_sibling (sibling))
+      index++;
+
+    g_array_prepend_val (path, index);
+
+    widget = parent;
+  }
+
+  return path;
+}
+
+static GtkWidget *
+resolve_focus_path (GtkWidget *page,
+                    GArray    *path)
+{
+  GtkWidget *widget = page;
+  guint i;
+
+  for (i = 0; widget && i < path->len; i++) {
+    guint j, index = g_array_index (path, guint, i);
+
+    widget = gtk_widget_get_first_child (widget);
+
+    for (j = 0; widget && j < index; j++)
+      widget = gtk_widget_get_next_sibling (widget);
+  }
+
+  return widget;
+}
+
+static void
+release_page (AdwNavigationPage *self)
+{
+  AdwNavigationPagePrivate *priv = adw_navigation_page_get_instance_private (self);
+
+  if (gtk_widget_get_mapped (GTK_WIDGET (self)))
+    return;
+
+  if (priv->child_func && priv->child) {
+    if (priv->last_focus) {
+      g_clear_pointer (&priv->last_focus_path, g_array_unref);
+      priv->last_focus_path = get_focus_path (GTK_WIDGET (self), priv->last_focus);
+      set_last_focus (self, NULL);
+    }
+
+    adw_navigation_page_set_child (self, NULL);
+  }
+
+  if (gtk_widget_get_realized (GTK_WIDGET (self)))
+    gtk_widget_unrealize (GTK_WIDGET (self));
+}
+
+static void
+restore_page (AdwNavigationPage *self)
+{
+  AdwNavigationPagePrivate *priv = adw_navigation_page_get_instance_private (self);
+  GtkWidget *child;
+
+  if (priv->child || !priv->child_func)
+    return;
+
+  child = priv->child_func (self, priv->child_func_data);
+
+  if (!child)
+    return;
+
+  g_object_ref_sink (child);
+  adw_navigation_page_set_child (self, child);
+  g_object_unref (child);
+
+  if (priv->last_focus_path) {
+    set_last_focus (self, resolve_focus_path (GTK_WIDGET (self), priv->last_focus_path));
+    g_clear_pointer (&priv->last_focus_path, g_array_unref);
+  }
+}
+
 static void
 adw_navigation_page_realize (GtkWidget *widget)
 {
@@ -419,6 +535,10 @@ adw_navigation_page_dispose (GObject *object)
 
   g_clear_pointer (&priv->child, gtk_widget_unparent);
 
+  if (priv->child_func_data_destroy)
+    g_clear_pointer (&priv->child_func_data, priv->child_func_data_destroy);
+  priv->child_func = NULL;
+
   if (priv->child_view) {
     g_object_remove_weak_pointer (G_OBJECT (priv->child_view),
                                   (gpointer *) &priv->child_view);
@@ -437,6 +557,7 @@ adw_navigation_page_finalize (GObject *object)
 
   g_free (priv->title);
   g_free (priv->tag);
+  g_clear_pointer (&priv->last_focus_path, g_array_unref);
 
   if (priv->last_focus)
     g_object_remove_weak_pointer (G_OBJECT (priv->last_focus),
@@ -746,12 +867,8 @@ switch_page (AdwNavigationView *self,
 
     contains_focus = TRUE;
 
-    if (priv->last_focus)
-      g_object_remove_weak_pointer (G_OBJECT (priv->last_focus),
-                                    (gpointer *)&priv->last_focus);
-    priv->last_focus = focus;
-    g_object_add_weak_pointer (G_OBJECT (priv->last_focus),
-                               (gpointer *)&priv->last_focus);
+    g_clear_pointer (&priv->last_focus_path, g_array_unref);
+    set_last_focus (prev_page, focus);
   }
 
   if (!prev_page)
@@ -775,6 +892,8 @@ switch_page (AdwNavigationView *self,
   if (page) {
     AdwNavigationPagePrivate *priv = adw_navigation_page_get_instance_private (page);
 
+    restore_page (page);
+
     gtk_widget_set_child_visible (GTK_WIDGET (page), TRUE);
 
     if (page != self->showing_page)
@@ -805,6 +924,9 @@ switch_page (AdwNavigationView *self,
 
   adw_animation_reset (self->transition);
 
+  if (prev_page != self->hiding_page)
+    g_clear_object (&self->transition_texture);
+
   if (prev_page && prev_page != self->hiding_page)
     adw_navigation_page_hiding (prev_page);
 
@@ -903,6 +1025,39 @@ pop_from_stack (AdwNavigationView *self,
   g_slist_free_full (popped, g_object_unref);
 }
 
+static void
+apply_retention_policy (AdwNavigationView *self)
+{
+  GtkWidget *child;
+  guint n_items;
+
+  if (self->retention_depth < 0)
+    return;
+
+  n_items = g_list_model_get_n_items (G_LIST_MODEL (self->navigation_stack));
+
+  for (child = gtk_widget_get_first_child (GTK_WIDGET (self));
+       child;
+       child = gtk_widget_get_next_sibling (child)) {
+    AdwNavigationPage *page;
+    guint pos;
+
+    if (!ADW_IS_NAVIGATION_PAGE (child))
+      continue;
+
+    page = ADW_NAVIGATION_PAGE (child);
+
+    if (page == self->showing_page || page == self->hiding_page)
+      continue;
+
+    if (g_list_store_find (self->navigation_stack, page, &pos) &&
+        (int) (n_items - 1 - pos) <= self->retention_depth)
+      continue;
+
+    release_page (page);
+  }
+}
+
 static void
 transition_cb (double             value,
                AdwNavigationView *self)
@@ -955,9 +1110,12 @@ transition_done_cb (AdwNavigationView *self)
 
   self->transition_cancel = FALSE;
   self->transition_progress = 0;
+  g_clear_object (&self->transition_texture);
 
   gtk_widget_set_child_visible (self->shield, FALSE);
   gtk_widget_queue_resize (GTK_WIDGET (self));
+
+  apply_retention_policy (self);
 }
 
 static void
@@ -1275,6 +1433,8 @@ prepare_cb (AdwSwipeTracker        *tracker,
 
   self->gesture_active = TRUE;
 
+  restore_page (self->showing_page);
+
   gtk_widget_set_child_visible (GTK_WIDGET (self->showing_page), TRUE);
 
   adw_spring_animation_set_value_from (ADW_SPRING_ANIMATION (self->transition), 0);
@@ -1408,6 +1568,74 @@ adw_navigation_view_measure (GtkWidget      *widget,
     *natural_baseline = MAX (nat_baseline, last_nat_baseline);
 }
 
+static inline gboolean
+is_page_cached (AdwNavigationView *self,
+                GtkWidget         *page)
+{
+  return self->transition_texture && page == GTK_WIDGET (self->hiding_page);
+}
+
+static GdkTexture *
+render_page_texture (AdwNavigationView *self,
+                     GtkWidget         *page)
+{
+  GtkWidget *widget = GTK_WIDGET (self);
+  GtkNative *native = gtk_widget_get_native (widget);
+  GskRenderer *renderer;
+  GtkSnapshot *snapshot;
+  GskRenderNode *node;
+  GdkTexture *texture;
+  graphene_rect_t bounds;
+  int scale;
+
+  if (!native)
+    return NULL;
+
+  renderer = gtk_native_get_renderer (native);
+
+  if (!renderer || !gtk_widget_compute_bounds (page, widget, &bounds))
+    return NULL;
+
+  scale = gtk_widget_get_scale_factor (widget);
+
+  snapshot = gtk_snapshot_new ();
+  gtk_snapshot_scale (snapshot, scale, scale);
+  gtk_widget_snapshot_child (widget, page, snapshot);
+  node = gtk_snapshot_free_to_node (snapshot);
+
+  if (!node)
+    return NULL;
+
+  texture = gsk_renderer_render_texture (renderer, node,
+                                         &GRAPHENE_RECT_INIT (bounds.origin.x * scale,
+                                                              bounds.origin.y * scale,
+                                                              gtk_widget_get_width (widget) * scale,
+                                                              gtk_widget_get_height (widget) * scale));
+
+  gsk_render_node_unref (node);
+
+  return texture;
+}
+
+static void
+snapshot_page (AdwNavigationView *self,
+               GtkWidget         *page,
+               GtkSnapshot       *snapshot,
+               int                x)
+{
+  GtkWidget *widget = GTK_WIDGET (self);
+
+  if (is_page_cached (self, page)) {
+    gtk_snapshot_append_texture (snapshot, self->transition_texture,
+                                 &GRAPHENE_RECT_INIT (x, 0,
+                                                      gtk_widget_get_width (widget),
+                                                      gtk_widget_get_height (widget)));
+    return;
+  }
+
+  gtk_widget_snapshot_child (widget, page, snapshot);
+}
+
 static void
 adw_navigation_view_size_allocate (GtkWidget *widget,
                                    int        width,
@@ -1454,7 +1682,16 @@ adw_navigation_view_size_allocate (GtkWidget *widget,
 
   offset = (int) round (progress * width);
 
-  if (static_page)
+  /* The cached page is only allocated again if it needs to be re-rendered */
+  if (self->transition_texture) {
+    int scale = gtk_widget_get_scale_factor (widget);
+
+    if (gdk_texture_get_width (self->transition_texture) != width * scale ||
+        gdk_texture_get_height (self->transition_texture) != height * scale)
+      g_clear_object (&self->transition_texture);
+  }
+
+  if (static_page && !is_page_cached (self, static_page))
     gtk_widget_allocate (static_page, width, height, baseline, NULL);
 
   if (gtk_widget_should_layout (self->shield)) {
@@ -1473,7 +1710,7 @@ adw_navigation_view_size_allocate (GtkWidget *widget,
   }
 
   if (is_rtl) {
-    if (moving_page)
+    if (moving_page && !is_page_cached (self, moving_page))
       gtk_widget_allocate (moving_page, width, height, baseline,
                            gsk_transform_translate (NULL, &GRAPHENE_POINT_INIT (-offset, 0)));
 
@@ -1482,7 +1719,7 @@ adw_navigation_view_size_allocate (GtkWidget *widget,
                                      baseline, width - offset, 0, progress,
                                      GTK_PAN_DIRECTION_LEFT);
   } else {
-    if (moving_page)
+    if (moving_page && !is_page_cached (self, moving_page))
       gtk_widget_allocate (moving_page, width, height, baseline,
                            gsk_transform_translate (NULL, &GRAPHENE_POINT_INIT (offset, 0)));
 
@@ -1526,6 +1763,10 @@ adw_navigation_view_snapshot (GtkWidget   *widget,
       moving_page = GTK_WIDGET (self->showing_page);
   }
 
+  if (self->cache_transitions && !self->transition_texture &&
+      self->hiding_page != self->showing_page)
+    self->transition_texture = render_page_texture (self, GTK_WIDGET (self->hiding_page));
+
   width = gtk_widget_get_width (widget);
   height = gtk_widget_get_height (widget);
   progress = self->transition_progress;
@@ -1545,7 +1786,7 @@ adw_navigation_view_snapshot (GtkWidget   *widget,
 
   if (static_page) {
     gtk_snapshot_push_clip (snapshot, &GRAPHENE_RECT_INIT (clip_x, 0, clip_width, height));
-    gtk_widget_snapshot_child (widget, static_page, snapshot);
+    snapshot_page (self, static_page, snapshot, 0);
     gtk_snapshot_pop (snapshot);
   }
 
@@ -1558,7 +1799,7 @@ adw_navigation_view_snapshot (GtkWidget   *widget,
 
   if (moving_page) {
     gtk_snapshot_push_clip (snapshot, &GRAPHENE_RECT_INIT (clip_x, 0, clip_width, height));
-    gtk_widget_snapshot_child (widget, moving_page, snapshot);
+    snapshot_page (self, moving_page, snapshot, clip_x);
     gtk_snapshot_pop (snapshot);
   }
 
@@ -1602,6 +1843,16 @@ adw_navigation_view_direction_changed (GtkWidget        *widget,
   adw_swipe_tracker_set_reversed (self->swipe_tracker, is_rtl);
 }
 
+static void
+adw_navigation_view_unrealize (GtkWidget *widget)
+{
+  AdwNavigationView *self = ADW_NAVIGATION_VIEW (widget);
+
+  g_clear_object (&self->transition_texture);
+
+  GTK_WIDGET_CLASS (adw_navigation_view_parent_class)->unrealize (widget);
+}
+
 static void
 adw_navigation_view_dispose (GObject *object)
 {
@@ -1614,6 +1865,7 @@ adw_navigation_view_dispose (GObject *object)
 
   g_clear_object (&self->shadow_helper);
   g_clear_object (&self->swipe_tracker);
+  g_clear_object (&self->transition_texture);
 
   g_clear_pointer (&self->shield, gtk_widget_unparent);
 
@@ -1660,6 +1912,12 @@ adw_navigation_view_get_property (GObject    *object,
   case PROP_NAVIGATION_STACK:
     g_value_take_object (value, adw_navigation_view_get_navigation_stack (self));
     break;
+  case PROP_CACHE_TRANSITIONS:
+    g_value_set_boolean (value, adw_navigation_view_get_cache_transitions (self));
+    break;
+  case PROP_RETENTION_DEPTH:
+    g_value_set_int (value, adw_navigation_view_get_retention_depth (self));
+    break;
   default:
     G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
   }
@@ -1680,6 +1938,12 @@ adw_navigation_view_set_property (GObject      *object,
   case PROP_POP_ON_ESCAPE:
     adw_navigation_view_set_pop_on_escape (self, g_value_get_boolean (value));
     break;
+  case PROP_CACHE_TRANSITIONS:
+    adw_navigation_view_set_cache_transitions (self, g_value_get_boolean (value));
+    break;
+  case PROP_RETENTION_DEPTH:
+    adw_navigation_view_set_retention_depth (self, g_value_get_int (value));
+    break;
   default:
     G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
   }
@@ -1712,6 +1976,7 @@ adw_navigation_view_class_init (AdwNavigationViewClass *klass)
   widget_class->measure = adw_navigation_view_measure;
   widget_class->size_allocate = adw_navigation_view_size_allocate;
   widget_class->snapshot = adw_navigation_view_snapshot;
+  widget_class->unrealize = adw_navigation_view_unrealize;
   widget_class->root = adw_navigation_view_root;
   widget_class->unroot = adw_navigation_view_unroot;
   widget_class->direction_changed = adw_navigation_view_direction_changed;
@@ -1775,6 +2040,46 @@ adw_navigation_view_class_init (AdwNavigationViewClass *klass)
                          G_TYPE_LIST_MODEL,
                          G_PARAM_READABLE | G_PARAM_STATIC_STRINGS);
 
+  /**
+   * AdwNavigationView:cache-transitions: (attributes org.gtk.Property.get=adw_navigation_view_get_cache_transitions org.gtk.Property.set=adw_navigation_view_set_cache_transitions)
+   *
+   * Whether to render the outgoing page into a texture during transitions.
+   *
+   * When enabled, the page that is being hidden is rendered once when a
+   * transition or a swipe starts, and that image is used for the rest of the
+   * transition instead of drawing the page on every frame. This makes
+   * transitions away from complex pages, such as long lists or web content,
+   * smoother.
+   *
+   * The outgoing page won't be updated while the transition is running.
+   *
+   * Since: 1.5
+   */
+  props[PROP_CACHE_TRANSITIONS] =
+    g_param_spec_boolean ("cache-transitions", NULL, NULL,
+                          FALSE,
+                          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS | G_PARAM_EXPLICIT_NOTIFY);
+
+  /**
+   * AdwNavigationView:retention-depth: (attributes org.gtk.Property.get=adw_navigation_view_get_retention_depth org.gtk.Property.set=adw_navigation_view_set_retention_depth)
+   *
+   * How many pages below the visible page keep their resources.
+   *
+   * Once a transition finishes, pages that are more than this many levels
+   * below the visible page in the navigation stack, as well as pages that
+   * aren't in the navigation stack at all, are unrealized. If such a page has
+   * a child function set with [method@NavigationPage.set_child_func], its
+   * child is dropped as well, and is created again when the page is shown.
+   *
+   * If set to -1, all pages are kept.
+   *
+   * Since: 1.5
+   */
+  props[PROP_RETENTION_DEPTH] =
+    g_param_spec_int ("retention-depth", NULL, NULL,
+                      -1, G_MAXINT, -1,
+                      G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS | G_PARAM_EXPLICIT_NOTIFY);
+
   g_object_class_install_properties (object_class, LAST_PROP, props);
 
   /**
@@ -1912,6 +2217,7 @@ adw_navigation_view_init (AdwNavigationView *self)
 
   self->animate_transitions = TRUE;
   self->pop_on_escape = TRUE;
+  self->retention_depth = -1;
 
   self->navigation_stack = g_list_store_new (ADW_TYPE_NAVIGATION_PAGE);
 
@@ -2352,6 +2658,45 @@ adw_navigation_page_set_can_pop (AdwNavigationPage *self,
   g_object_notify_by_pspec (G_OBJECT (self), page_props[PAGE_PROP_CAN_POP]);
 }
 
+/**
+ * adw_navigation_page_set_child_func:
+ * @self: a navigation page
+ * @child_func: (nullable) (scope notified) (closure user_data) (destroy user_data_destroy): a function that creates the child of @self
+ * @user_data: user data for @child_func
+ * @user_data_destroy: destroy notifier for @user_data
+ *
+ * Sets a function to create the child of @self when needed.
+ *
+ * When @self is about to be shown without a child, @child_func is called to
+ * create one. This allows [class@NavigationView] to drop the child of a page
+ * that is deep in the navigation stack, see
+ * [property@NavigationView:retention-depth].
+ *
+ * The tag, title and other properties of @self are kept, and the focus is
+ * restored to the widget at the same position in the new child.
+ *
+ * Since: 1.5
+ */
+void
+adw_navigation_page_set_child_func (AdwNavigationPage          *self,
+                                    AdwNavigationPageChildFunc  child_func,
+                                    gpointer                    user_data,
+                                    GDestroyNotify              user_data_destroy)
+{
+  AdwNavigationPagePrivate *priv;
+
+  g_return_if_fail (ADW_IS_NAVIGATION_PAGE (self));
+
+  priv = adw_navigation_page_get_instance_private (self);
+
+  if (priv->child_func_data_destroy)
+    priv->child_func_data_destroy (priv->child_func_data);
+
+  priv->child_func = child_func;
+  priv->child_func_data = user_data;
+  priv->child_func_data_destroy = user_data_destroy;
+}
+
 AdwNavigationView *
 adw_navigation_page_get_child_view (AdwNavigationPage *self)
 {
@@ -3100,3 +3445,141 @@ adw_navigation_view_get_navigation_stack (AdwNavigationView *self)
 
   return self->navigation_stack_model;
 }
+
+/**
+ * adw_navigation_view_get_cache_transitions: (attributes org.gtk.Method.get_property=cache-transitions)
+ * @self: a navigation view
+ *
+ * Gets whether @self renders the outgoing page into a texture during
+ * transitions.
+ *
+ * Returns: whether to cache the outgoing page during transitions
+ *
+ * Since: 1.5
+ */
+gboolean
+adw_navigation_view_get_cache_transitions (AdwNavigationView *self)
+{
+  g_return_val_if_fail (ADW_IS_NAVIGATION_VIEW (self), FALSE);
+
+  return self->cache_transitions;
+}
+
+/**
+ * adw_navigation_view_set_cache_transitions: (attributes org.gtk.Method.set_property=cache-transitions)
+ * @self: a navigation view
+ * @cache_transitions: whether to cache the outgoing page during transitions
+ *
+ * Sets whether @self renders the outgoing page into a texture during
+ * transitions.
+ *
+ * When enabled, the page that is being hidden is rendered once when a
+ * transition or a swipe starts, and that image is used for the rest of the
+ * transition instead of drawing the page on every frame.
+ *
+ * The outgoing page won't be updated while the transition is running.
+ *
+ * Since: 1.5
+ */
+void
+adw_navigation_view_set_cache_transitions (AdwNavigationView *self,
+                                           gboolean           cache_transitions)
+{
+  g_return_if_fail (ADW_IS_NAVIGATION_VIEW (self));
+
+  cache_transitions = !!cache_transitions;
+
+  if (cache_transitions == self->cache_transitions)
+    return;
+
+  self->cache_transitions = cache_transitions;
+
+  if (!cache_transitions && self->transition_texture) {
+    g_clear_object (&self->transition_texture);
+    gtk_widget_queue_allocate (GTK_WIDGET (self));
+  }
+
+  g_object_notify_by_pspec (G_OBJECT (self), props[PROP_CACHE_TRANSITIONS]);
+}
+
+/**
+ * adw_navigation_view_get_retention_depth: (attributes org.gtk.Method.get_property=retention-depth)
+ * @self: a navigation view
+ *
+ * Gets how many pages below the visible page keep their resources.
+ *
+ * Returns: the retention depth, or -1 if all pages are kept
+ *
+ * Since: 1.5
+ */
+int
+adw_navigation_view_get_retention_depth (AdwNavigationView *self)
+{
+  g_return_val_if_fail (ADW_IS_NAVIGATION_VIEW (self), -1);
+
+  return self->retention_depth;
+}
+
+/**
+ * adw_navigation_view_set_retention_depth: (attributes org.gtk.Method.set_property=retention-depth)
+ * @self: a navigation view
+ * @retention_depth: the retention depth, or -1 to keep all pages
+ *
+ * Sets how many pages below the visible page keep their resources.
+ *
+ * Once a transition finishes, pages that are more than @retention_depth levels
+ * below the visible page in the navigation stack, as well as pages that aren't
+ * in the navigation stack at all, are unrealized. If such a page has a child
+ * function set with [method@NavigationPage.set_child_func], its child is
+ * dropped as well, and is created again when the page is shown.
+ *
+ * Since: 1.5
+ */
+void
+adw_navigation_view_set_retention_depth (AdwNavigationView *self,
+                                         int                retention_depth)
+{
+  g_return_if_fail (ADW_IS_NAVIGATION_VIEW (self));
+  g_return_if_fail (retention_depth >= -1);
+
+  if (retention_depth == self->retention_depth)
+    return;
+
+  self->retention_depth = retention_depth;
+
+  if (!self->showing_page && !self->hiding_page)
+    apply_retention_policy (self);
+
+  g_object_notify_by_pspec (G_OBJECT (self), props[PROP_RETENTION_DEPTH]);
+}
+
+/**
+ * adw_navigation_view_get_n_realized_pages:
+ * @self: a navigation view
+ *
+ * Gets the number of pages in @self that are currently realized.
+ *
+ * This includes the visible page and any pages that have been shown before and
+ * haven't been released according to [property@NavigationView:retention-depth].
+ *
+ * Returns: the number of realized pages
+ *
+ * Since: 1.5
+ */
+guint
+adw_navigation_view_get_n_realized_pages (AdwNavigationView *self)
+{
+  GtkWidget *child;
+  guint n_pages = 0;
+
+  g_return_val_if_fail (ADW_IS_NAVIGATION_VIEW (self), 0);
+
+  for (child = gtk_widget_get_first_child (GTK_WIDGET (self));
+       child;
+       child = gtk_widget_get_next_sibling (child)) {
+    if (ADW_IS_NAVIGATION_PAGE (child) && gtk_widget_get_realized (child))
+      n_pages++;
+  }
+
+  return n_pages;
+}
@@ -75,6 +75,20 @@ struct _AdwNavigationPageClass
   gpointer padding[8];
 };
 
+/**
+ * AdwNavigationPageChildFunc:
+ * @page: the page that needs a child
+ * @user_data: (closure): user data
+ *
+ * Called to create the child of @page when it's about to be shown without one.
+ *
+ * Returns: (transfer none) (nullable): the new child
+ *
+ * Since: 1.5
+ */
+typedef GtkWidget *(*AdwNavigationPageChildFunc) (AdwNavigationPage *page,
+                                                  gpointer           user_data);
+
 ADW_AVAILABLE_IN_1_4
 AdwNavigationPage *adw_navigation_page_new (GtkWidget  *child,
                                             const char *title) G_GNUC_WARN_UNUSED_RESULT;
@@ -108,6 +122,12 @@ ADW_AVAILABLE_IN_1_4
 void     adw_navigation_page_set_can_pop (AdwNavigationPage *self,
                                           gboolean           can_pop);
 
+ADW_AVAILABLE_IN_1_5
+void adw_navigation_page_set_child_func (AdwNavigationPage          *self,
+                                         AdwNavigationPageChildFunc  child_func,
+                                         gpointer                    user_data,
+                                         GDestroyNotify              user_data_destroy);
+
 #define ADW_TYPE_NAVIGATION_VIEW (adw_navigation_view_get_type())
 
 ADW_AVAILABLE_IN_1_4
@@ -179,4 +199,19 @@ void     adw_navigation_view_set_pop_on_escape (AdwNavigationView *self,
 ADW_AVAILABLE_IN_1_4
 GListModel *adw_navigation_view_get_navigation_stack (AdwNavigationView *self);
 
+ADW_AVAILABLE_IN_1_5
+gboolean adw_navigation_view_get_cache_transitions (AdwNavigationView *self);
+ADW_AVAILABLE_IN_1_5
+void     adw_navigation_view_set_cache_transitions (AdwNavigationView *self,
+                                                    gboolean           cache_transitions);
+
+ADW_AVAILABLE_IN_1_5
+int  adw_navigation_view_get_retention_depth (AdwNavigationView *self);
+ADW_AVAILABLE_IN_1_5
+void adw_navigation_view_set_retention_depth (AdwNavigationView *self,
+                                              int                retention_depth);
+
+ADW_AVAILABLE_IN_1_5
+guint adw_navigation_view_get_n_realized_pages (AdwNavigationView *self);
+
 G_END_DECLS
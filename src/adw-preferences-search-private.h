@@ -0,0 +1,38 @@
+/*
+ * Copyright (C) 2024 GNOME Foundation, Inc.
+ *
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#pragma once
+
+#if !defined(_ADVAITA_INSIDE) && !defined(ADVAITA_COMPILATION)
+#error "Only <advaita.h> can be included directly."
+#endif
+
+#include <gtk/gtk.h>
+#include "adw-preferences-row.h"
+
+G_BEGIN_DECLS
+
+char *adw_strip_mnemonic (const char *src);
+
+ADW_AVAILABLE_IN_ALL
+char *adw_preferences_search_normalize (const char *terms);
+
+ADW_AVAILABLE_IN_ALL
+int adw_preferences_search_row_score (AdwPreferencesRow *row,
+                                      const char        *terms);
+
+ADW_AVAILABLE_IN_ALL
+gboolean adw_preferences_search_row_matches (AdwPreferencesRow *row,
+                                             const char        *terms);
+
+ADW_AVAILABLE_IN_ALL
+guint adw_preferences_search_get_serial (void);
+
+ADW_AVAILABLE_IN_ALL
+GtkFilterChange adw_preferences_search_get_change (const char *old_terms,
+                                                   const char *new_terms);
+
+G_END_DECLS
@@ -0,0 +1,357 @@
+/*
+ * Copyright (C) 2024 GNOME Foundation, Inc.
+ *
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#include "config.h"
+
+#include "adw-preferences-search-private.h"
+
+#include "adw-action-row.h"
+
+#define INDEX_KEY "-adw-preferences-search-index"
+
+#define SCORE_EXACT 1000
+#define SCORE_TITLE_PREFIX 800
+#define SCORE_TITLE_WORD 600
+#define SCORE_TITLE_SUBSTRING 400
+#define SCORE_SUBTITLE_WORD 300
+#define SCORE_TITLE_FUZZY 200
+#define SCORE_SUBTITLE_SUBSTRING 100
+#define FUZZY_GAP_PENALTY 10
+
+/* The normalized title and subtitle of a row, computed the first time the row
+ * is searched and dropped whenever one of the properties they depend on
+ * changes. The score for the last terms is kept as well, since sorting asks
+ * for it many times. */
+typedef struct {
+  char *title;
+  char *subtitle;
+  gboolean valid;
+
+  char *score_terms;
+  int score;
+} SearchIndex;
+
+static guint search_serial;
+
+/* Copied and modified from gtklabel.c, separate_uline_pattern() */
+char *
+adw_strip_mnemonic (const char *src)
+{
+  char *new_str = g_new (char, strlen (src) + 1);
+  char *dest = new_str;
+  gboolean underscore = FALSE;
+
+  while (*src) {
+    gunichar c;
+    const char *next_src;
+
+    c = g_utf8_get_char (src);
+    if (c == (gunichar) -1) {
+      g_warning ("Invalid input string");
+
+      g_free (new_str);
+
+      return NULL;
+    }
+
+    next_src = g_utf8_next_char (src);
+
+    if (underscore) {
+      while (src < next_src)
+        *dest++ = *src++;
+
+      underscore = FALSE;
+    } else {
+      if (c == '_'){
+        underscore = TRUE;
+        src = next_src;
+      } else {
+        while (src < next_src)
+          *dest++ = *src++;
+      }
+    }
+  }
+
+  *dest = 0;
+
+  return new_str;
+}
+
+static char *
+make_comparable (const char        *src,
+                 AdwPreferencesRow *row,
+                 gboolean           allow_underline)
+{
+  char *plaintext = g_utf8_casefold (src ? src : "", -1);
+  GError *error = NULL;
+
+  if (adw_preferences_row_get_use_markup (row)) {
+    char *parsed = NULL;
+
+    if (pango_parse_markup (plaintext, -1, 0, NULL, &parsed, NULL, &error)) {
+      g_free (plaintext);
+      plaintext = parsed;
+    } else {
+      g_critical ("Couldn't parse markup: %s", error->message);
+      g_clear_error (&error);
+    }
+  }
+
+  if (allow_underline && adw_preferences_row_get_use_underline (row)) {
+    char *comparable = adw_strip_mnemonic (plaintext);
+    g_free (plaintext);
+    return comparable;
+  }
+
+  return plaintext;
+}
+
+static void
+invalidate_index (SearchIndex *index)
+{
+  g_clear_pointer (&index->title, g_free);
+  g_clear_pointer (&index->subtitle, g_free);
+  g_clear_pointer (&index->score_terms, g_free);
+  index->valid = FALSE;
+}
+
+static void
+search_index_free (SearchIndex *index)
+{
+  invalidate_index (index);
+  g_free (index);
+}
+
+static void
+row_notify_cb (AdwPreferencesRow *row,
+               GParamSpec        *pspec,
+               SearchIndex       *index)
+{
+  const char *name = g_param_spec_get_name (pspec);
+
+  if (!g_strcmp0 (name, "title") ||
+      !g_strcmp0 (name, "subtitle") ||
+      !g_strcmp0 (name, "use-markup") ||
+      !g_strcmp0 (name, "use-underline")) {
+    invalidate_index (index);
+    search_serial++;
+  }
+}
+
+static SearchIndex *
+get_index (AdwPreferencesRow *row)
+{
+  SearchIndex *index = g_object_get_data (G_OBJECT (row), INDEX_KEY);
+
+  if (!index) {
+    index = g_new0 (SearchIndex, 1);
+
+    g_object_set_data_full (G_OBJECT (row), INDEX_KEY, index,
+                            (GDestroyNotify) search_index_free);
+    g_signal_connect (row, "notify", G_CALLBACK (row_notify_cb), index);
+  }
+
+  if (!index->valid) {
+    index->title = make_comparable (adw_preferences_row_get_title (row), row, TRUE);
+
+    if (ADW_IS_ACTION_ROW (row))
+      index->subtitle = make_comparable (adw_action_row_get_subtitle (ADW_ACTION_ROW (row)), row, FALSE);
+
+    index->valid = TRUE;
+  }
+
+  return index;
+}
+
+static gboolean
+is_word_start (const char *text,
+               const char *p)
+{
+  if (p == text)
+    return TRUE;
+
+  return !g_unichar_isalnum (g_utf8_get_char (g_utf8_prev_char (p)));
+}
+
+static int
+score_substring (const char *text,
+                 const char *token,
+                 int         prefix_score,
+                 int         word_score,
+                 int         substring_score)
+{
+  const char *p;
+  int score = 0;
+
+  if (!text)
+    return 0;
+
+  if (g_str_has_prefix (text, token))
+    return prefix_score;
+
+  for (p = strstr (text, token); p; p = strstr (p + 1, token)) {
+    if (is_word_start (text, p))
+      return word_score;
+
+    score = substring_score;
+  }
+
+  return score;
+}
+
+/* Matches the characters of @token in order, with fewer and shorter gaps
+ * between them scoring higher. Greedy, so it's linear in the text length. */
+static int
+score_subsequence (const char *text,
+                   const char *token)
+{
+  const char *t = token;
+  const char *p;
+  gboolean started = FALSE, in_gap = FALSE;
+  int penalty = 0;
+
+  if (!text)
+    return 0;
+
+  for (p = text; *p && *t; p = g_utf8_next_char (p)) {
+    if (g_utf8_get_char (p) == g_utf8_get_char (t)) {
+      t = g_utf8_next_char (t);
+      started = TRUE;
+      in_gap = FALSE;
+    } else if (started) {
+      if (!in_gap)
+        penalty += FUZZY_GAP_PENALTY;
+
+      penalty++;
+      in_gap = TRUE;
+    }
+  }
+
+  if (*t)
+    return 0;
+
+  return MAX (SCORE_TITLE_FUZZY - penalty, 1);
+}
+
+static int
+score_token (SearchIndex *index,
+             const char  *token)
+{
+  int score;
+
+  score = score_substring (index->title, token,
+                           SCORE_TITLE_PREFIX,
+                           SCORE_TITLE_WORD,
+                           SCORE_TITLE_SUBSTRING);
+
+  if (score == 0)
+    score = score_subsequence (index->title, token);
+
+  return MAX (score, score_substring (index->subtitle, token,
+                                      SCORE_SUBTITLE_WORD,
+                                      SCORE_SUBTITLE_WORD,
+                                      SCORE_SUBTITLE_SUBSTRING));
+}
+
+static int
+score_terms (SearchIndex *index,
+             const char  *terms)
+{
+  char **tokens = g_strsplit_set (terms, " \t\n", -1);
+  int score = 1;
+  int i;
+
+  for (i = 0; tokens[i]; i++) {
+    int token_score;
+
+    if (!*tokens[i])
+      continue;
+
+    token_score = score_token (index, tokens[i]);
+
+    if (token_score == 0) {
+      score = 0;
+      break;
+    }
+
+    score += token_score;
+  }
+
+  if (score > 0 && !g_strcmp0 (index->title, terms))
+    score += SCORE_EXACT;
+
+  g_strfreev (tokens);
+
+  return score;
+}
+
+char *
+adw_preferences_search_normalize (const char *terms)
+{
+  char *normalized = g_utf8_casefold (terms ? terms : "", -1);
+
+  return g_strstrip (normalized);
+}
+
+/* @terms must come from adw_preferences_search_normalize().
+ *
+ * Every whitespace-separated token of @terms must be found either in the title,
+ * possibly with other characters in between, or in the subtitle. Prefix and
+ * word start matches in the title rank highest, followed by other title
+ * matches, word start matches in the subtitle, scattered title matches and
+ * other subtitle matches. */
+int
+adw_preferences_search_row_score (AdwPreferencesRow *row,
+                                  const char        *terms)
+{
+  SearchIndex *index = get_index (row);
+
+  if (index->score_terms && !strcmp (index->score_terms, terms))
+    return index->score;
+
+  g_free (index->score_terms);
+  index->score_terms = g_strdup (terms);
+  index->score = score_terms (index, terms);
+
+  return index->score;
+}
+
+gboolean
+adw_preferences_search_row_matches (AdwPreferencesRow *row,
+                                    const char        *terms)
+{
+  return adw_preferences_search_row_score (row, terms) > 0;
+}
+
+/* Incremented whenever the text of a row that has been searched before
+ * changes. Filter results computed before that may be stale, so callers must
+ * compare it with the value from their last search, and refilter from scratch
+ * if it's different. */
+guint
+adw_preferences_search_get_serial (void)
+{
+  return search_serial;
+}
+
+/* If the new terms contain the old ones, every token of the old terms is a part
+ * of a token of the new terms, so the new terms can only match fewer rows and
+ * only the current matches need to be checked again. The same goes the other
+ * way around. */
+GtkFilterChange
+adw_preferences_search_get_change (const char *old_terms,
+                                   const char *new_terms)
+{
+  if (!old_terms || !new_terms)
+    return GTK_FILTER_CHANGE_DIFFERENT;
+
+  if (strstr (new_terms, old_terms))
+    return GTK_FILTER_CHANGE_MORE_STRICT;
+
+  if (strstr (old_terms, new_terms))
+    return GTK_FILTER_CHANGE_LESS_STRICT;
+
+  return GTK_FILTER_CHANGE_DIFFERENT;
+}
@@ -16,6 +16,7 @@
 #include "adw-navigation-view.h"
 #include "adw-preferences-group-private.h"
 #include "adw-preferences-page-private.h"
+#include "adw-preferences-search-private.h"
 #include "adw-toast-overlay.h"
 #include "adw-view-stack.h"
 #include "adw-widget-utils-private.h"
@@ -63,7 +64,10 @@ typedef struct
   gboolean can_navigate_back;
 
   GtkFilter *filter;
-  GtkFilterListModel *filter_model;
+  GtkSorter *sorter;
+  GtkSortListModel *results_model;
+  char *search_terms;
+  guint search_serial;
 
   int n_pages;
 
@@ -91,107 +95,27 @@ enum {
 
 static GParamSpec *props[LAST_PROP];
 
-/* Copied and modified from gtklabel.c, separate_uline_pattern() */
-static char *
-strip_mnemonic (const char *src)
-{
-  char *new_str = g_new (char, strlen (src) + 1);
-  char *dest = new_str;
-  gboolean underscore = FALSE;
-
-  while (*src) {
-    gunichar c;
-    const char *next_src;
-
-    c = g_utf8_get_char (src);
-    if (c == (gunichar) -1) {
-      g_warning ("Invalid input string");
-
-      g_free (new_str);
-
-      return NULL;
-    }
-
-    next_src = g_utf8_next_char (src);
-
-    if (underscore) {
-      while (src < next_src)
-        *dest++ = *src++;
-
-      underscore = FALSE;
-    } else {
-      if (c == '_'){
-        underscore = TRUE;
-        src = next_src;
-      } else {
-        while (src < next_src)
-          *dest++ = *src++;
-      }
-    }
-  }
-
-  *dest = 0;
-
-  return new_str;
-}
-
-static char *
-make_comparable (const char        *src,
-                 AdwPreferencesRow *row,
-                 gboolean           allow_underline)
-{
-  char *plaintext = g_utf8_casefold (src, -1);
-  GError *error = NULL;
-
-  if (adw_preferences_row_get_use_markup (row)) {
-    char *parsed = NULL;
-
-    if (pango_parse_markup (plaintext, -1, 0, NULL, &parsed, NULL, &error)) {
-      g_free (plaintext);
-      plaintext = parsed;
-    } else {
-      g_critical ("Couldn't parse markup: %s", error->message);
-      g_clear_error (&error);
-    }
-  }
-
-  if (allow_underline && adw_preferences_row_get_use_underline (row)) {
-    char *comparable = strip_mnemonic (plaintext);
-    g_free (plaintext);
-    return comparable;
-  }
-
-  return plaintext;
-}
-
 static gboolean
 filter_search_results (AdwPreferencesRow    *row,
                        AdwPreferencesWindow *self)
 {
   AdwPreferencesWindowPrivate *priv = adw_preferences_window_get_instance_private (self);
-  char *terms, *title;
-  gboolean result = FALSE;
 
   g_assert (ADW_IS_PREFERENCES_ROW (row));
 
-  terms = g_utf8_casefold (gtk_editable_get_text (GTK_EDITABLE (priv->search_entry)), -1);
-  title = make_comparable (adw_preferences_row_get_title (row), row, TRUE);
-
-  if (!!strstr (title, terms)) {
-    result = TRUE;
-  } else if (ADW_IS_ACTION_ROW (row)) {
-    char *subtitle = make_comparable (adw_action_row_get_subtitle (ADW_ACTION_ROW(row)), row, FALSE);
-
-    if (!!strstr (subtitle, terms))
-      result = TRUE;
-
-    g_free (subtitle);
-  }
+  return adw_preferences_search_row_matches (row, priv->search_terms ? priv->search_terms : "");
+}
 
-  g_free (title);
-  g_free (terms);
+static int
+sort_search_results (AdwPreferencesRow    *a,
+                     AdwPreferencesRow    *b,
+                     AdwPreferencesWindow *self)
+{
+  AdwPreferencesWindowPrivate *priv = adw_preferences_window_get_instance_private (self);
+  const char *terms = priv->search_terms ? priv->search_terms : "";
 
-  return result;
+  return adw_preferences_search_row_score (b, terms) -
+         adw_preferences_search_row_score (a, terms);
 }
 
 static int
@@ -236,7 +160,7 @@ create_search_row_subtitle (AdwPreferencesWindow *self,
     const char *title = adw_preferences_page_get_title (ADW_PREFERENCES_PAGE (page));
 
     if (adw_preferences_page_get_use_underline (ADW_PREFERENCES_PAGE (page)))
-      page_title = strip_mnemonic (title);
+      page_title = adw_strip_mnemonic (title);
     else
       page_title = g_strdup (title);
 
@@ -326,7 +250,7 @@ search_results_map (AdwPreferencesWindow *self)
   AdwPreferencesWindowPrivate *priv = adw_preferences_window_get_instance_private (self);
 
   gtk_list_box_bind_model (priv->search_results,
-                           G_LIST_MODEL (priv->filter_model),
+                           G_LIST_MODEL (priv->results_model),
                            (GtkListBoxCreateWidgetFunc) new_search_row_for_preference,
                            self,
                            NULL);
@@ -460,11 +384,27 @@ static void
 search_changed_cb (AdwPreferencesWindow *self)
 {
   AdwPreferencesWindowPrivate *priv = adw_preferences_window_get_instance_private (self);
-  guint n;
+  GtkFilterChange change;
+  char *terms;
+  guint serial, n;
 
-  gtk_filter_changed (priv->filter, GTK_FILTER_CHANGE_DIFFERENT);
+  terms = adw_preferences_search_normalize (gtk_editable_get_text (GTK_EDITABLE (priv->search_entry)));
+  serial = adw_preferences_search_get_serial ();
 
-  n = g_list_model_get_n_items (G_LIST_MODEL (priv->filter_model));
+  /* The previous results can't be reused if a row's text has changed since */
+  if (serial != priv->search_serial)
+    change = GTK_FILTER_CHANGE_DIFFERENT;
+  else
+    change = adw_preferences_search_get_change (priv->search_terms, terms);
+
+  g_free (priv->search_terms);
+  priv->search_terms = terms;
+  priv->search_serial = serial;
+
+  gtk_filter_changed (priv->filter, change);
+  gtk_sorter_changed (priv->sorter, GTK_SORTER_CHANGE_DIFFERENT);
+
+  n = g_list_model_get_n_items (G_LIST_MODEL (priv->results_model));
 
   gtk_stack_set_visible_child_name (priv->search_stack, n > 0 ? "results" : "no-results");
 }
@@ -535,7 +475,8 @@ adw_preferences_window_dispose (GObject *object)
   AdwPreferencesWindow *self = ADW_PREFERENCES_WINDOW (object);
   AdwPreferencesWindowPrivate *priv = adw_preferences_window_get_instance_private (self);
 
-  g_clear_object (&priv->filter_model);
+  g_clear_object (&priv->results_model);
+  g_clear_pointer (&priv->search_terms, g_free);
 
   G_OBJECT_CLASS (adw_preferences_window_parent_class)->dispose (object);
 }
@@ -714,7 +655,10 @@ adw_preferences_window_init (AdwPreferencesWindow *self)
                                                 NULL,
                                                 NULL));
   model = G_LIST_MODEL (gtk_flatten_list_model_new (model));
-  priv->filter_model = gtk_filter_list_model_new (model, priv->filter);
+  model = G_LIST_MODEL (gtk_filter_list_model_new (model, priv->filter));
+
+  priv->sorter = GTK_SORTER (gtk_custom_sorter_new ((GCompareDataFunc) sort_search_results, self, NULL));
+  priv->results_model = gtk_sort_list_model_new (model, priv->sorter);
 
   gtk_search_entry_set_key_capture_widget (priv->search_entry, GTK_WIDGET (self));
 }
@@ -0,0 +1,32 @@
+/*
+ * Copyright (C) 2024 GNOME Foundation, Inc.
+ *
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#pragma once
+
+#if !defined(_ADVAITA_INSIDE) && !defined(ADVAITA_COMPILATION)
+#error "Only <advaita.h> can be included directly."
+#endif
+
+#include <glib.h>
+
+G_BEGIN_DECLS
+
+typedef enum {
+  ADW_DEBUG_STARTUP = 1 << 0,
+} AdwDebugFlags;
+
+AdwDebugFlags adw_get_debug_flags (void);
+
+#define ADW_DEBUG_CHECK(type) G_UNLIKELY (adw_get_debug_flags () & ADW_DEBUG_##type)
+
+gint64 adw_profiler_get_current_time (void);
+
+void adw_profiler_add_mark (gint64      begin_time,
+                            gint64      duration,
+                            const char *name,
+                            const char *message);
+
+G_END_DECLS
@@ -0,0 +1,75 @@
+/*
+ * Copyright (C) 2024 GNOME Foundation, Inc.
+ *
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#include "config.h"
+
+#include "adw-profiler-private.h"
+
+#ifdef HAVE_SYSPROF
+#include <sysprof-capture.h>
+#endif
+
+static const GDebugKey debug_keys[] = {
+  { "startup", ADW_DEBUG_STARTUP },
+};
+
+/*
+ * adw_get_debug_flags:
+ *
+ * Returns the flags set in the `ADW_DEBUG` environment variable, as a comma
+ * separated list of keys. `ADW_DEBUG=help` prints the available keys.
+ */
+AdwDebugFlags
+adw_get_debug_flags (void)
+{
+  static gboolean initialized = FALSE;
+  static AdwDebugFlags flags = 0;
+
+  if (G_UNLIKELY (!initialized)) {
+    flags = g_parse_debug_string (g_getenv ("ADW_DEBUG"),
+                                  debug_keys,
+                                  G_N_ELEMENTS (debug_keys));
+    initialized = TRUE;
+  }
+
+  return flags;
+}
+
+/*
+ * adw_profiler_get_current_time:
+ *
+ * Returns the current monotonic time in nanoseconds, using the same clock as
+ * sysprof.
+ */
+gint64
+adw_profiler_get_current_time (void)
+{
+#ifdef HAVE_SYSPROF
+  return SYSPROF_CAPTURE_CURRENT_TIME;
+#else
+  return g_get_monotonic_time () * 1000;
+#endif
+}
+
+/*
+ * adw_profiler_add_mark:
+ * @begin_time: the start time, from adw_profiler_get_current_time()
+ * @duration: the duration, in nanoseconds
+ * @name: the name of the mark
+ * @message: (nullable): additional details
+ *
+ * Adds a mark to the sysprof capture, if the profiler is running.
+ */
+void
+adw_profiler_add_mark (gint64      begin_time,
+                       gint64      duration,
+                       const char *name,
+                       const char *message)
+{
+#ifdef HAVE_SYSPROF
+  sysprof_collector_mark (begin_time, duration, "libadvaita", name, message);
+#endif
+}
@@ -17,13 +17,30 @@
 #define PORTAL_OBJECT_PATH "/org/freedesktop/portal/desktop"
 #define PORTAL_SETTINGS_INTERFACE "org.freedesktop.portal.Settings"
 
-#define PORTAL_ERROR_NOT_FOUND "org.freedesktop.portal.Error.NotFound"
+#define PORTAL_DEFAULT_TIMEOUT 500
+
+static const char * const portal_namespaces[] = {
+  "org.freedesktop.appearance",
+  "org.gnome.desktop.a11y.interface",
+  "org.gnome.desktop.interface",
+  NULL,
+};
 
 struct _AdwSettingsImplPortal
 {
   AdwSettingsImpl parent_instance;
 
   GDBusProxy *settings_portal;
+  GCancellable *cancellable;
+  guint timeout_id;
+  guint disabled_idle_id;
+  gboolean pending;
+
+  /* The a{sa{sv}} reply of ReadAll */
+  GVariant *settings;
+
+  gboolean enable_color_scheme;
+  gboolean enable_high_contrast;
 
   gboolean found_color_scheme;
 
@@ -36,6 +53,27 @@ struct _AdwSettingsImplPortal
 
 G_DEFINE_FINAL_TYPE (AdwSettingsImplPortal, adw_settings_impl_portal, ADW_TYPE_SETTINGS_IMPL)
 
+static int
+get_portal_timeout (void)
+{
+  const char *env = g_getenv ("ADW_PORTAL_TIMEOUT");
+  gint64 timeout;
+  char *end;
+
+  if (!env || !*env)
+    return PORTAL_DEFAULT_TIMEOUT;
+
+  timeout = g_ascii_strtoll (env, &end, 10);
+
+  if (*end || timeout <= 0 || timeout > G_MAXINT) {
+    g_warning ("Invalid value for ADW_PORTAL_TIMEOUT: %s (Expected a positive number of milliseconds)", env);
+
+    return PORTAL_DEFAULT_TIMEOUT;
+  }
+
+  return (int) timeout;
+}
+
 static gboolean
 read_setting (AdwSettingsImplPortal  *self,
               const char             *schema,
@@ -43,63 +81,40 @@ read_setting (AdwSettingsImplPortal  *self,
               const char             *type,
               GVariant              **out)
 {
-  GError *error = NULL;
-  GVariant *ret;
-  GVariant *child, *child2;
-  GVariantType *out_type;
-  gboolean result = FALSE;
-
-  ret = g_dbus_proxy_call_sync (self->settings_portal,
-                                "Read",
-                                g_variant_new ("(ss)", schema, name),
-                                G_DBUS_CALL_FLAGS_NONE,
-                                G_MAXINT,
-                                NULL,
-                                &error);
-  if (error) {
-    if (error->domain == G_DBUS_ERROR &&
-        error->code == G_DBUS_ERROR_SERVICE_UNKNOWN) {
-      g_debug ("Portal not found: %s", error->message);
-    } else if (error->domain == G_DBUS_ERROR &&
-               error->code == G_DBUS_ERROR_UNKNOWN_METHOD) {
-      g_debug ("Portal doesn't provide settings: %s", error->message);
-    } else if (g_dbus_error_is_remote_error (error)) {
-      char *remote_error = g_dbus_error_get_remote_error (error);
-
-      if (!g_strcmp0 (remote_error, PORTAL_ERROR_NOT_FOUND)) {
-        g_debug ("Setting %s.%s of type %s not found", schema, name, type);
-      }
-      g_free (remote_error);
-    } else {
-      g_critical ("Couldn't read the %s setting: %s", name, error->message);
-    }
+  GVariant *namespace;
+  GVariant *value;
+
+  if (!self->settings)
+    return FALSE;
 
-    g_clear_error (&error);
+  namespace = g_variant_lookup_value (self->settings, schema, G_VARIANT_TYPE_VARDICT);
+  if (!namespace) {
+    g_debug ("Setting %s.%s of type %s not found", schema, name, type);
 
     return FALSE;
   }
 
-  g_variant_get (ret, "(v)", &child);
-  g_variant_get (child, "v", &child2);
+  value = g_variant_lookup_value (namespace, name, NULL);
+  g_variant_unref (namespace);
 
-  out_type = g_variant_type_new (type);
-  if (g_variant_type_equal (g_variant_get_type (child2), out_type)) {
-    *out = child2;
+  if (!value) {
+    g_debug ("Setting %s.%s of type %s not found", schema, name, type);
 
-    result = TRUE;
-  } else {
+    return FALSE;
+  }
+
+  if (!g_variant_is_of_type (value, G_VARIANT_TYPE (type))) {
     g_critical ("Invalid type for %s.%s: expected %s, got %s",
-                schema, name, type, g_variant_get_type_string (child2));
+                schema, name, type, g_variant_get_type_string (value));
 
-    g_variant_unref (child2);
+    g_variant_unref (value);
+
+    return FALSE;
   }
 
-  g_variant_type_free (out_type);
-  g_variant_unref (child);
-  g_variant_unref (ret);
-  g_clear_error (&error);
+  *out = value;
 
-  return result;
+  return TRUE;
 }
 
 static AdwSystemColorScheme
@@ -164,56 +179,55 @@ changed_cb (GDBusProxy            *proxy,
 }
 
 static void
-adw_settings_impl_portal_dispose (GObject *object)
+report_error (GError *error)
 {
-  AdwSettingsImplPortal *self = ADW_SETTINGS_IMPL_PORTAL (object);
-
-  g_clear_object (&self->settings_portal);
-
-  G_OBJECT_CLASS (adw_settings_impl_portal_parent_class)->dispose (object);
+  if (g_error_matches (error, G_DBUS_ERROR, G_DBUS_ERROR_SERVICE_UNKNOWN)) {
+    g_debug ("Portal not found: %s", error->message);
+  } else if (g_error_matches (error, G_DBUS_ERROR, G_DBUS_ERROR_UNKNOWN_METHOD)) {
+    g_debug ("Portal doesn't provide settings: %s", error->message);
+  } else {
+    g_critical ("Couldn't read the portal settings: %s", error->message);
+  }
 }
 
 static void
-adw_settings_impl_portal_class_init (AdwSettingsImplPortalClass *klass)
+read_all_cb (GDBusProxy            *proxy,
+             GAsyncResult          *result,
+             AdwSettingsImplPortal *self)
 {
-  GObjectClass *object_class = G_OBJECT_CLASS (klass);
-
-  object_class->dispose = adw_settings_impl_portal_dispose;
-}
+  GError *error = NULL;
+  GVariant *ret, *variant;
 
-static void
-adw_settings_impl_portal_init (AdwSettingsImplPortal *self)
-{
-}
+  ret = g_dbus_proxy_call_finish (proxy, result, &error);
 
-AdwSettingsImpl *
-adw_settings_impl_portal_new (gboolean enable_color_scheme,
-                              gboolean enable_high_contrast)
-{
-  AdwSettingsImplPortal *self = g_object_new (ADW_TYPE_SETTINGS_IMPL_PORTAL, NULL);
-  GError *error = NULL;
-  GVariant *variant;
+  if (!ret) {
+    if (g_error_matches (error, G_IO_ERROR, G_IO_ERROR_CANCELLED)) {
+      g_error_free (error);
 
-  if (adw_get_disable_portal ())
-    return ADW_SETTINGS_IMPL (self);
+      return;
+    }
 
-  self->settings_portal = g_dbus_proxy_new_for_bus_sync (G_BUS_TYPE_SESSION,
-                                                         G_DBUS_PROXY_FLAGS_NONE,
-                                                         NULL,
-                                                         PORTAL_BUS_NAME,
-                                                         PORTAL_OBJECT_PATH,
-                                                         PORTAL_SETTINGS_INTERFACE,
-                                                         NULL,
-                                                         &error);
-  if (error) {
-    g_debug ("Settings portal not found: %s", error->message);
+    g_clear_handle_id (&self->timeout_id, g_source_remove);
+    self->pending = FALSE;
 
+    report_error (error);
     g_error_free (error);
 
-    return ADW_SETTINGS_IMPL (self);
+    /* Let AdwSettings know we're done, even though we found nothing */
+    adw_settings_impl_set_features (ADW_SETTINGS_IMPL (self), FALSE, FALSE);
+
+    return;
   }
 
-  if (enable_color_scheme &&
+  g_clear_handle_id (&self->timeout_id, g_source_remove);
+  self->pending = FALSE;
+
+  g_variant_get (ret, "(@a{sa{sv}})", &self->settings);
+  g_variant_unref (ret);
+
+  /* Set the values before enabling the features, so that the change is
+   * picked up in one go when AdwSettings switches to us */
+  if (self->enable_color_scheme &&
       read_setting (self, "org.freedesktop.appearance",
                     "color-scheme", "u", &variant)) {
     self->found_color_scheme = TRUE;
@@ -224,7 +238,7 @@ adw_settings_impl_portal_new (gboolean enable_color_scheme,
     g_variant_unref (variant);
   }
 
-  if (enable_high_contrast) {
+  if (self->enable_high_contrast) {
     if (read_setting (self, "org.freedesktop.appearance",
                     "contrast", "u", &variant)) {
       self->high_contrast_portal_state = HIGH_CONTRAST_STATE_FDO;
@@ -243,20 +257,161 @@ adw_settings_impl_portal_new (gboolean enable_color_scheme,
     }
   }
 
+  if (self->found_color_scheme || self->high_contrast_portal_state != HIGH_CONTRAST_STATE_NONE)
+    g_signal_connect (self->settings_portal, "g-signal",
+                      G_CALLBACK (changed_cb), self);
+
   adw_settings_impl_set_features (ADW_SETTINGS_IMPL (self),
                                   self->found_color_scheme,
                                   self->high_contrast_portal_state != HIGH_CONTRAST_STATE_NONE);
+}
 
-  if (self->found_color_scheme || self->high_contrast_portal_state != HIGH_CONTRAST_STATE_NONE)
-    g_signal_connect (self->settings_portal, "g-signal",
-                      G_CALLBACK (changed_cb), self);
+static void
+timeout_cb (AdwSettingsImplPortal *self)
+{
+  self->timeout_id = 0;
+
+  g_debug ("Portal didn't reply in time, using the fallbacks until it does");
+
+  /* Stop waiting, but keep the call pending: AdwSettings uses the other impls
+   * until read_all_cb() reports the features again */
+  adw_settings_impl_set_features (ADW_SETTINGS_IMPL (self), FALSE, FALSE);
+}
+
+static void
+disabled_cb (AdwSettingsImplPortal *self)
+{
+  self->disabled_idle_id = 0;
+
+  /* Nothing will ever be read, let AdwSettings drop the cached values */
+  adw_settings_impl_set_features (ADW_SETTINGS_IMPL (self), FALSE, FALSE);
+}
+
+static void
+proxy_ready_cb (GObject               *source,
+                GAsyncResult          *result,
+                AdwSettingsImplPortal *self)
+{
+  GError *error = NULL;
+  GDBusProxy *proxy;
+
+  proxy = g_dbus_proxy_new_for_bus_finish (result, &error);
+
+  if (!proxy) {
+    if (g_error_matches (error, G_IO_ERROR, G_IO_ERROR_CANCELLED)) {
+      g_error_free (error);
+
+      return;
+    }
+
+    g_clear_handle_id (&self->timeout_id, g_source_remove);
+    self->pending = FALSE;
+
+    g_debug ("Settings portal not found: %s", error->message);
+    g_error_free (error);
+
+    adw_settings_impl_set_features (ADW_SETTINGS_IMPL (self), FALSE, FALSE);
+
+    return;
+  }
+
+  self->settings_portal = proxy;
+
+  /* The deadline is handled by timeout_cb(), a D-Bus activated portal can
+   * take a while to start and we still want its reply */
+  g_dbus_proxy_call (self->settings_portal,
+                     "ReadAll",
+                     g_variant_new ("(^as)", portal_namespaces),
+                     G_DBUS_CALL_FLAGS_NONE,
+                     G_MAXINT,
+                     self->cancellable,
+                     (GAsyncReadyCallback) read_all_cb,
+                     self);
+}
+
+static void
+adw_settings_impl_portal_dispose (GObject *object)
+{
+  AdwSettingsImplPortal *self = ADW_SETTINGS_IMPL_PORTAL (object);
+
+  if (self->cancellable)
+    g_cancellable_cancel (self->cancellable);
+
+  g_clear_handle_id (&self->timeout_id, g_source_remove);
+  g_clear_handle_id (&self->disabled_idle_id, g_source_remove);
+  g_clear_object (&self->cancellable);
+  g_clear_object (&self->settings_portal);
+  g_clear_pointer (&self->settings, g_variant_unref);
+
+  G_OBJECT_CLASS (adw_settings_impl_portal_parent_class)->dispose (object);
+}
+
+static void
+adw_settings_impl_portal_class_init (AdwSettingsImplPortalClass *klass)
+{
+  GObjectClass *object_class = G_OBJECT_CLASS (klass);
+
+  object_class->dispose = adw_settings_impl_portal_dispose;
+}
+
+static void
+adw_settings_impl_portal_init (AdwSettingsImplPortal *self)
+{
+}
+
+/*
+ * The portal is queried asynchronously with a single ReadAll call, so creating
+ * the impl never blocks on D-Bus. It reports no features until the reply
+ * arrives, then emits AdwSettingsImpl::features-changed. If the portal is
+ * missing or disabled with ADW_DISABLE_PORTAL, it still emits it, but keeps
+ * reporting no features and the other impls stay in charge. If it doesn't
+ * answer within ADW_PORTAL_TIMEOUT milliseconds, the signal is emitted early
+ * with no features, and again once the reply arrives. In that case
+ * adw_settings_impl_portal_is_pending() keeps returning %TRUE until then.
+ */
+AdwSettingsImpl *
+adw_settings_impl_portal_new (gboolean enable_color_scheme,
+                              gboolean enable_high_contrast)
+{
+  AdwSettingsImplPortal *self = g_object_new (ADW_TYPE_SETTINGS_IMPL_PORTAL, NULL);
+
+  if (adw_get_disable_portal ()) {
+    self->disabled_idle_id = g_idle_add_once ((GSourceOnceFunc) disabled_cb, self);
+
+    return ADW_SETTINGS_IMPL (self);
+  }
+
+  self->enable_color_scheme = enable_color_scheme;
+  self->enable_high_contrast = enable_high_contrast;
+  self->cancellable = g_cancellable_new ();
+  self->pending = TRUE;
+  self->timeout_id = g_timeout_add_once (get_portal_timeout (),
+                                         (GSourceOnceFunc) timeout_cb,
+                                         self);
+
+  g_dbus_proxy_new_for_bus (G_BUS_TYPE_SESSION,
+                            G_DBUS_PROXY_FLAGS_DO_NOT_LOAD_PROPERTIES,
+                            NULL,
+                            PORTAL_BUS_NAME,
+                            PORTAL_OBJECT_PATH,
+                            PORTAL_SETTINGS_INTERFACE,
+                            self->cancellable,
+                            (GAsyncReadyCallback) proxy_ready_cb,
+                            self);
 
   return ADW_SETTINGS_IMPL (self);
 }
 
 gboolean adw_settings_impl_portal_enabled (AdwSettingsImpl *self) {
   return ADW_IS_SETTINGS_IMPL_PORTAL (self) &&
-    ADW_SETTINGS_IMPL_PORTAL (self)->settings_portal != NULL;
+    ADW_SETTINGS_IMPL_PORTAL (self)->settings != NULL;
+}
+
+gboolean
+adw_settings_impl_portal_is_pending (AdwSettingsImpl *self)
+{
+  return ADW_IS_SETTINGS_IMPL_PORTAL (self) &&
+    ADW_SETTINGS_IMPL_PORTAL (self)->pending;
 }
 
 GDBusProxy *
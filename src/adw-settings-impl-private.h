@@ -26,16 +26,20 @@ struct _AdwSettingsImplClass
   GObjectClass parent_class;
 };
 
+ADW_AVAILABLE_IN_ALL
 gboolean adw_settings_impl_get_has_color_scheme  (AdwSettingsImpl *self);
+ADW_AVAILABLE_IN_ALL
 gboolean adw_settings_impl_get_has_high_contrast (AdwSettingsImpl *self);
 void     adw_settings_impl_set_features          (AdwSettingsImpl *self,
                                                   gboolean         has_color_scheme,
                                                   gboolean         has_high_contrast);
 
+ADW_AVAILABLE_IN_ALL
 AdwSystemColorScheme adw_settings_impl_get_color_scheme (AdwSettingsImpl      *self);
 void                 adw_settings_impl_set_color_scheme (AdwSettingsImpl      *self,
                                                          AdwSystemColorScheme  color_scheme);
 
+ADW_AVAILABLE_IN_ALL
 gboolean adw_settings_impl_get_high_contrast (AdwSettingsImpl *self);
 void     adw_settings_impl_set_high_contrast (AdwSettingsImpl *self,
                                               gboolean         high_contrast);
@@ -43,6 +47,7 @@ void     adw_settings_impl_set_high_contrast (AdwSettingsImpl *self,
 gboolean adw_get_disable_portal (void);
 
 gboolean adw_settings_impl_portal_enabled (AdwSettingsImpl *self);
+gboolean adw_settings_impl_portal_is_pending (AdwSettingsImpl *self);
 
 #include <gio/gio.h>
 GSettings *adw_settings_impl_gsettings_get_interface_settings (AdwSettingsImpl *self);
@@ -73,6 +78,7 @@ AdwSettingsImpl *adw_settings_impl_win32_new (gboolean enable_color_scheme,
 
 G_DECLARE_FINAL_TYPE (AdwSettingsImplPortal, adw_settings_impl_portal, ADW, SETTINGS_IMPL_PORTAL, AdwSettingsImpl)
 
+ADW_AVAILABLE_IN_ALL
 AdwSettingsImpl *adw_settings_impl_portal_new (gboolean enable_color_scheme,
                                                gboolean enable_high_contrast) G_GNUC_WARN_UNUSED_RESULT;
 #endif
@@ -24,7 +24,7 @@ typedef struct
 G_DEFINE_ABSTRACT_TYPE_WITH_PRIVATE (AdwSettingsImpl, adw_settings_impl, G_TYPE_OBJECT)
 
 enum {
-  SIGNAL_PREPARE,
+  SIGNAL_FEATURES_CHANGED,
   SIGNAL_COLOR_SCHEME_CHANGED,
   SIGNAL_HIGH_CONTRAST_CHANGED,
   SIGNAL_LAST_SIGNAL,
@@ -35,6 +35,19 @@ static guint signals[SIGNAL_LAST_SIGNAL];
 static void
 adw_settings_impl_class_init (AdwSettingsImplClass *klass)
 {
+  signals[SIGNAL_FEATURES_CHANGED] =
+    g_signal_new ("features-changed",
+                  G_TYPE_FROM_CLASS (klass),
+                  G_SIGNAL_RUN_FIRST,
+                  0,
+                  NULL, NULL,
+                  adw_marshal_VOID__VOID,
+                  G_TYPE_NONE,
+                  0);
+  g_signal_set_va_marshaller (signals[SIGNAL_FEATURES_CHANGED],
+                              G_TYPE_FROM_CLASS (klass),
+                              adw_marshal_VOID__VOIDv);
+
   signals[SIGNAL_COLOR_SCHEME_CHANGED] =
     g_signal_new ("color-scheme-changed",
                   G_TYPE_FROM_CLASS (klass),
@@ -100,6 +113,10 @@ adw_settings_impl_set_features (AdwSettingsImpl *self,
 
   priv->has_color_scheme = !!has_color_scheme;
   priv->has_high_contrast = !!has_high_contrast;
+
+  /* Emitted unconditionally: impls that load asynchronously use this to
+   * announce that they are done, even if they found nothing */
+  g_signal_emit (G_OBJECT (self), signals[SIGNAL_FEATURES_CHANGED], 0);
 }
 
 AdwSystemColorScheme
@@ -12,8 +12,19 @@
 
 #include "adw-settings-impl-private.h"
 
+#include <errno.h>
+#include <glib/gstdio.h>
 #include <gtk/gtk.h>
 
+#define CACHE_GROUP "Settings"
+
+typedef enum {
+  ADW_YARU_ACCENT_SOURCE_NONE,
+  ADW_YARU_ACCENT_SOURCE_PORTAL,
+  ADW_YARU_ACCENT_SOURCE_GTK,
+  ADW_YARU_ACCENT_SOURCE_GSETTINGS,
+} AdwYaruAccentSource;
+
 struct _AdwSettings
 {
   GObject parent_instance;
@@ -27,6 +38,14 @@ struct _AdwSettings
   gboolean system_supports_color_schemes;
 
   gchar *yaru_accent;
+  AdwYaruAccentSource yaru_accent_source;
+
+  char *cache_path;
+  char *cache_contents;
+  guint save_cache_idle_id;
+  gboolean color_scheme_from_cache;
+  gboolean high_contrast_from_cache;
+  gboolean yaru_accent_from_cache;
 
   gboolean override;
   gboolean system_supports_color_schemes_override;
@@ -49,6 +68,17 @@ static GParamSpec *props[LAST_PROP];
 
 static AdwSettings *default_instance;
 
+static void save_cache (AdwSettings *self);
+
+static void
+queue_save_cache (AdwSettings *self)
+{
+  if (!self->cache_path || self->save_cache_idle_id)
+    return;
+
+  self->save_cache_idle_id = g_idle_add_once ((GSourceOnceFunc) save_cache, self);
+}
+
 static void
 set_color_scheme (AdwSettings          *self,
                   AdwSystemColorScheme  color_scheme)
@@ -60,6 +90,8 @@ set_color_scheme (AdwSettings          *self,
 
   if (!self->override)
     g_object_notify_by_pspec (G_OBJECT (self), props[PROP_COLOR_SCHEME]);
+
+  queue_save_cache (self);
 }
 
 static void
@@ -73,6 +105,8 @@ set_high_contrast (AdwSettings *self,
 
   if (!self->override)
     g_object_notify_by_pspec (G_OBJECT (self), props[PROP_HIGH_CONTRAST]);
+
+  queue_save_cache (self);
 }
 
 static void
@@ -110,6 +144,137 @@ init_debug (AdwSettings *self,
   }
 }
 
+static gboolean
+get_disable_settings_cache (void)
+{
+  const char *disable_cache = g_getenv ("ADW_DISABLE_SETTINGS_CACHE");
+
+  return disable_cache && disable_cache[0] == '1';
+}
+
+/*
+ * The last resolved values are kept in a small key file in the user cache
+ * directory, so that the first frame can already use them while the portal
+ * is still being queried. The live sources then correct them if needed.
+ */
+static void
+load_cache (AdwSettings *self)
+{
+  GKeyFile *key_file;
+  GError *error = NULL;
+  char *color_scheme;
+
+  self->cache_path = g_build_filename (g_get_user_cache_dir (),
+                                       "libadvaita",
+                                       "settings.ini",
+                                       NULL);
+
+  if (!g_file_get_contents (self->cache_path, &self->cache_contents, NULL, &error)) {
+    if (!g_error_matches (error, G_FILE_ERROR, G_FILE_ERROR_NOENT))
+      g_debug ("Couldn't read the settings cache: %s", error->message);
+
+    g_error_free (error);
+
+    return;
+  }
+
+  key_file = g_key_file_new ();
+
+  if (!g_key_file_load_from_data (key_file, self->cache_contents, -1,
+                                  G_KEY_FILE_NONE, &error)) {
+    g_debug ("Invalid settings cache: %s", error->message);
+
+    g_error_free (error);
+    g_key_file_free (key_file);
+
+    return;
+  }
+
+  color_scheme = g_key_file_get_string (key_file, CACHE_GROUP, "color-scheme", NULL);
+  if (color_scheme) {
+    GEnumClass *enum_class = g_type_class_ref (ADW_TYPE_SYSTEM_COLOR_SCHEME);
+    GEnumValue *value = g_enum_get_value_by_nick (enum_class, color_scheme);
+
+    if (value) {
+      self->color_scheme = value->value;
+      self->color_scheme_from_cache = TRUE;
+    }
+
+    g_type_class_unref (enum_class);
+    g_free (color_scheme);
+  }
+
+  if (g_key_file_has_key (key_file, CACHE_GROUP, "high-contrast", NULL)) {
+    self->high_contrast = g_key_file_get_boolean (key_file, CACHE_GROUP, "high-contrast", NULL);
+    self->high_contrast_from_cache = TRUE;
+  }
+
+  self->yaru_accent = g_key_file_get_string (key_file, CACHE_GROUP, "yaru-accent", NULL);
+  self->yaru_accent_from_cache = self->yaru_accent != NULL;
+
+  g_key_file_free (key_file);
+}
+
+static void
+save_cache (AdwSettings *self)
+{
+  GKeyFile *key_file;
+  GError *error = NULL;
+  char *contents, *dir;
+
+  self->save_cache_idle_id = 0;
+
+  key_file = g_key_file_new ();
+
+  if (self->system_supports_color_schemes) {
+    GEnumClass *enum_class = g_type_class_ref (ADW_TYPE_SYSTEM_COLOR_SCHEME);
+    GEnumValue *value = g_enum_get_value (enum_class, self->color_scheme);
+
+    g_key_file_set_string (key_file, CACHE_GROUP, "color-scheme", value->value_nick);
+
+    g_type_class_unref (enum_class);
+  }
+
+  g_key_file_set_boolean (key_file, CACHE_GROUP, "high-contrast", self->high_contrast);
+
+  if (self->yaru_accent)
+    g_key_file_set_string (key_file, CACHE_GROUP, "yaru-accent", self->yaru_accent);
+
+  contents = g_key_file_to_data (key_file, NULL, NULL);
+  g_key_file_free (key_file);
+
+  if (!g_strcmp0 (contents, self->cache_contents)) {
+    g_free (contents);
+
+    return;
+  }
+
+  dir = g_path_get_dirname (self->cache_path);
+
+  if (g_mkdir_with_parents (dir, 0700) < 0) {
+    g_debug ("Couldn't create %s: %s", dir, g_strerror (errno));
+
+    g_free (dir);
+    g_free (contents);
+
+    return;
+  }
+
+  g_free (dir);
+
+  if (!g_file_set_contents (self->cache_path, contents, -1, &error)) {
+    g_debug ("Couldn't write the settings cache: %s", error->message);
+
+    g_error_free (error);
+    g_free (contents);
+
+    return;
+  }
+
+  g_free (self->cache_contents);
+  self->cache_contents = contents;
+}
+
 static void
 register_impl (AdwSettings     *self,
                AdwSettingsImpl *impl,
@@ -146,6 +311,8 @@ update_yaru_accent_from_theme (AdwSettings *self,
 
   g_assert (self->yaru_accent == NULL);
 
+  self->yaru_accent_from_cache = FALSE;
+
   if (g_str_has_prefix (theme_name, "Yaru")) {
     if (g_str_equal (theme_name, "Yaru") ||
         g_str_equal (theme_name, "Yaru-dark")) {
@@ -160,8 +327,11 @@ update_yaru_accent_from_theme (AdwSettings *self,
     }
   }
 
-  if (g_strcmp0 (old_accent, self->yaru_accent) != 0)
+  if (g_strcmp0 (old_accent, self->yaru_accent) != 0) {
     g_object_notify_by_pspec (G_OBJECT (self), props[PROP_YARU_ACCENT]);
+
+    queue_save_cache (self);
+  }
 }
 
 static gboolean
@@ -250,13 +420,6 @@ on_yaru_settings_portal_changed (GDBusProxy  *proxy,
   }
 }
 
-typedef enum {
-  ADW_YARU_ACCENT_SOURCE_NONE,
-  ADW_YARU_ACCENT_SOURCE_PORTAL,
-  ADW_YARU_ACCENT_SOURCE_GTK,
-  ADW_YARU_ACCENT_SOURCE_GSETTINGS,
-} AdwYaruAccentSource;
-
 static AdwYaruAccentSource
 update_yaru_accent (AdwSettings *self)
 {
@@ -278,6 +441,7 @@ init_yaru_accents (AdwSettings *self)
   AdwYaruAccentSource accent_source;
 
   accent_source = update_yaru_accent (self);
+  self->yaru_accent_source = accent_source;
 
   switch (accent_source) {
     case ADW_YARU_ACCENT_SOURCE_PORTAL:
@@ -307,6 +471,126 @@ init_yaru_accents (AdwSettings *self)
   }
 }
 
+/* A cached accent is only kept while the portal may still provide one */
+static void
+drop_cached_yaru_accent (AdwSettings *self)
+{
+  if (!self->yaru_accent_from_cache ||
+      self->yaru_accent_source != ADW_YARU_ACCENT_SOURCE_NONE ||
+      adw_settings_impl_portal_is_pending (self->platform_impl))
+    return;
+
+  self->yaru_accent_from_cache = FALSE;
+  g_clear_pointer (&self->yaru_accent, g_free);
+
+  g_object_notify_by_pspec (G_OBJECT (self), props[PROP_YARU_ACCENT]);
+
+  queue_save_cache (self);
+}
+
+static void
+disconnect_yaru_accent_source (AdwSettings *self)
+{
+  switch (self->yaru_accent_source) {
+    case ADW_YARU_ACCENT_SOURCE_PORTAL:
+      g_signal_handlers_disconnect_by_func (adw_settings_impl_portal_get_proxy (self->platform_impl),
+                                            on_yaru_settings_portal_changed, self);
+      break;
+
+    case ADW_YARU_ACCENT_SOURCE_GTK:
+      g_signal_handlers_disconnect_by_func (gdk_display_get_default (),
+                                            on_yaru_display_setting_changed, self);
+      break;
+
+    case ADW_YARU_ACCENT_SOURCE_GSETTINGS:
+      g_signal_handlers_disconnect_by_func (adw_settings_impl_gsettings_get_interface_settings (self->gsettings_impl),
+                                            update_yaru_accent_from_gsettings, self);
+      break;
+
+    case ADW_YARU_ACCENT_SOURCE_NONE:
+    default:
+      break;
+  }
+
+  self->yaru_accent_source = ADW_YARU_ACCENT_SOURCE_NONE;
+}
+
+static void
+disconnect_fallback_impls (AdwSettings *self,
+                           gpointer     func)
+{
+  if (self->gsettings_impl)
+    g_signal_handlers_disconnect_by_func (self->gsettings_impl, func, self);
+
+  if (self->legacy_impl)
+    g_signal_handlers_disconnect_by_func (self->legacy_impl, func, self);
+}
+
+/* The portal impl reads its settings asynchronously, so until it replies the
+ * values come from the fallback impls. Once it does, take over from them. */
+static void
+platform_features_changed_cb (AdwSettings *self)
+{
+  AdwSettingsImpl *impl = self->platform_impl;
+  gboolean found_color_scheme = FALSE;
+  gboolean found_high_contrast = FALSE;
+  gboolean system_supports_color_schemes;
+
+  g_signal_handlers_disconnect_by_func (impl, set_color_scheme, self);
+  g_signal_handlers_disconnect_by_func (impl, set_high_contrast, self);
+
+  register_impl (self, impl, &found_color_scheme, &found_high_contrast);
+
+  if (found_color_scheme)
+    disconnect_fallback_impls (self, set_color_scheme);
+
+  if (found_high_contrast)
+    disconnect_fallback_impls (self, set_high_contrast);
+
+  system_supports_color_schemes = self->system_supports_color_schemes;
+
+  /* If the portal couldn't confirm the cached values, forget them. Don't do
+   * that when it merely missed the deadline though: the reply is still on its
+   * way, and resetting now would only flash the defaults before it arrives. */
+  if (self->color_scheme_from_cache &&
+      !adw_settings_impl_portal_is_pending (impl)) {
+    self->color_scheme_from_cache = FALSE;
+
+    if (!found_color_scheme) {
+      set_color_scheme (self, ADW_SYSTEM_COLOR_SCHEME_DEFAULT);
+      system_supports_color_schemes = FALSE;
+    }
+  }
+
+  if (self->high_contrast_from_cache &&
+      !adw_settings_impl_portal_is_pending (impl)) {
+    self->high_contrast_from_cache = FALSE;
+
+    if (!found_high_contrast)
+      set_high_contrast (self, FALSE);
+  }
+
+  if (found_color_scheme)
+    system_supports_color_schemes = TRUE;
+
+  if (system_supports_color_schemes != self->system_supports_color_schemes) {
+    self->system_supports_color_schemes = system_supports_color_schemes;
+
+    if (!self->override)
+      g_object_notify_by_pspec (G_OBJECT (self), props[PROP_SYSTEM_SUPPORTS_COLOR_SCHEMES]);
+
+    queue_save_cache (self);
+  }
+
+  if (self->yaru_accent_source != ADW_YARU_ACCENT_SOURCE_PORTAL &&
+      adw_settings_impl_portal_enabled (impl)) {
+    disconnect_yaru_accent_source (self);
+    init_yaru_accents (self);
+  }
+
+  drop_cached_yaru_accent (self);
+}
+
 static void
 adw_settings_constructed (GObject *object)
 {
@@ -318,6 +602,10 @@ adw_settings_constructed (GObject *object)
 
   init_debug (self, &found_color_scheme, &found_high_contrast);
 
+  /* Don't let the debug overrides end up in the cache */
+  if (!found_color_scheme && !found_high_contrast && !get_disable_settings_cache ())
+    load_cache (self);
+
   if (!found_color_scheme || !found_high_contrast) {
 #ifdef __APPLE__
     self->platform_impl = adw_settings_impl_macos_new (!found_color_scheme, !found_high_contrast);
@@ -328,6 +616,9 @@ adw_settings_constructed (GObject *object)
 #endif
 
     register_impl (self, self->platform_impl, &found_color_scheme, &found_high_contrast);
+
+    g_signal_connect_swapped (self->platform_impl, "features-changed",
+                              G_CALLBACK (platform_features_changed_cb), self);
   }
 
   if (!found_color_scheme || !found_high_contrast) {
@@ -340,9 +631,19 @@ adw_settings_constructed (GObject *object)
     register_impl (self, self->legacy_impl, &found_color_scheme, &found_high_contrast);
   }
 
-  self->system_supports_color_schemes = found_color_scheme;
+  /* Values from live sources take precedence over the cached ones */
+  if (found_color_scheme)
+    self->color_scheme_from_cache = FALSE;
+
+  if (found_high_contrast)
+    self->high_contrast_from_cache = FALSE;
+
+  self->system_supports_color_schemes = found_color_scheme || self->color_scheme_from_cache;
 
   init_yaru_accents (self);
+  drop_cached_yaru_accent (self);
+
+  queue_save_cache (self);
 }
 
 static void
@@ -350,12 +651,19 @@ adw_settings_dispose (GObject *object)
 {
   AdwSettings *self = ADW_SETTINGS (object);
 
+  if (self->platform_impl)
+    g_signal_handlers_disconnect_by_data (self->platform_impl, self);
+
   g_clear_object (&self->platform_impl);
   g_clear_object (&self->gsettings_impl);
   g_clear_object (&self->legacy_impl);
 
   g_clear_pointer (&self->yaru_accent, g_free);
 
+  g_clear_handle_id (&self->save_cache_idle_id, g_source_remove);
+  g_clear_pointer (&self->cache_path, g_free);
+  g_clear_pointer (&self->cache_contents, g_free);
+
   G_OBJECT_CLASS (adw_settings_parent_class)->dispose (object);
 }
 
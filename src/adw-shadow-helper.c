@@ -20,6 +20,30 @@ struct _AdwShadowHelper
   GtkWidget *shadow;
   GtkWidget *border;
   GtkWidget *outline;
+
+  /* Resolved from CSS when the style, direction or size changes */
+  gboolean style_valid;
+  GtkPanDirection direction;
+  int length;
+  int dimming_width;
+  int dimming_height;
+  int shadow_size;
+  int border_size;
+  int outline_size;
+
+  gboolean nodes_valid;
+  GskRenderNode *dimming_node;
+  GskRenderNode *shadow_node;
+  GskRenderNode *border_node;
+  GskRenderNode *outline_node;
+
+  /* Updated every frame */
+  gboolean visible;
+  int x;
+  int y;
+  int width;
+  int height;
+  double progress;
 };
 
 G_DEFINE_FINAL_TYPE (AdwShadowHelper, adw_shadow_helper, G_TYPE_OBJECT);
@@ -32,34 +56,58 @@ enum {
 
 static GParamSpec *props[LAST_PROP];
 
+static void
+clear_nodes (AdwShadowHelper *self)
+{
+  g_clear_pointer (&self->dimming_node, gsk_render_node_unref);
+  g_clear_pointer (&self->shadow_node, gsk_render_node_unref);
+  g_clear_pointer (&self->border_node, gsk_render_node_unref);
+  g_clear_pointer (&self->outline_node, gsk_render_node_unref);
+
+  self->nodes_valid = FALSE;
+}
+
+static void
+gizmo_css_changed_cb (AdwGizmo *gizmo)
+{
+  AdwShadowHelper *self = g_object_get_data (G_OBJECT (gizmo), "-adw-shadow-helper");
+
+  if (!self)
+    return;
+
+  self->style_valid = FALSE;
+  clear_nodes (self);
+}
+
+static GtkWidget *
+create_gizmo (AdwShadowHelper *self,
+              const char      *css_name)
+{
+  GtkWidget *gizmo = adw_gizmo_new_with_role (css_name, GTK_ACCESSIBLE_ROLE_PRESENTATION,
+                                              NULL, NULL, NULL, NULL, NULL, NULL);
+
+  g_object_set_data (G_OBJECT (gizmo), "-adw-shadow-helper", self);
+  adw_gizmo_set_css_changed_func (ADW_GIZMO (gizmo), gizmo_css_changed_cb);
+
+  gtk_widget_add_css_class (gizmo, "left");
+  gtk_widget_set_visible (gizmo, FALSE);
+  gtk_widget_set_can_target (gizmo, FALSE);
+  gtk_widget_set_parent (gizmo, self->widget);
+
+  return gizmo;
+}
+
 static void
 adw_shadow_helper_constructed (GObject *object)
 {
   AdwShadowHelper *self = ADW_SHADOW_HELPER (object);
 
-  self->dimming = adw_gizmo_new_with_role ("dimming", GTK_ACCESSIBLE_ROLE_PRESENTATION,
-                                           NULL, NULL, NULL, NULL, NULL, NULL);
-  self->shadow = adw_gizmo_new_with_role ("shadow", GTK_ACCESSIBLE_ROLE_PRESENTATION,
-                                          NULL, NULL, NULL, NULL, NULL, NULL);
-  self->border = adw_gizmo_new_with_role ("border", GTK_ACCESSIBLE_ROLE_PRESENTATION,
-                                          NULL, NULL, NULL, NULL, NULL, NULL);
-  self->outline = adw_gizmo_new_with_role ("outline", GTK_ACCESSIBLE_ROLE_PRESENTATION,
-                                           NULL, NULL, NULL, NULL, NULL, NULL);
-
-  gtk_widget_set_visible (self->dimming, FALSE);
-  gtk_widget_set_visible (self->shadow, FALSE);
-  gtk_widget_set_visible (self->border, FALSE);
-  gtk_widget_set_visible (self->outline, FALSE);
-
-  gtk_widget_set_can_target (self->dimming, FALSE);
-  gtk_widget_set_can_target (self->shadow, FALSE);
-  gtk_widget_set_can_target (self->border, FALSE);
-  gtk_widget_set_can_target (self->outline, FALSE);
-
-  gtk_widget_set_parent (self->dimming, self->widget);
-  gtk_widget_set_parent (self->shadow, self->widget);
-  gtk_widget_set_parent (self->border, self->widget);
-  gtk_widget_set_parent (self->outline, self->widget);
+  self->dimming = create_gizmo (self, "dimming");
+  self->shadow = create_gizmo (self, "shadow");
+  self->border = create_gizmo (self, "border");
+  self->outline = create_gizmo (self, "outline");
+
+  self->direction = GTK_PAN_DIRECTION_LEFT;
 
   G_OBJECT_CLASS (adw_shadow_helper_parent_class)->constructed (object);
 }
@@ -73,6 +121,7 @@ adw_shadow_helper_dispose (GObject *object)
   g_clear_pointer (&self->shadow, gtk_widget_unparent);
   g_clear_pointer (&self->border, gtk_widget_unparent);
   g_clear_pointer (&self->outline, gtk_widget_unparent);
+  clear_nodes (self);
   self->widget = NULL;
 
   G_OBJECT_CLASS (adw_shadow_helper_parent_class)->dispose (object);
@@ -187,106 +236,207 @@ set_style_classes (AdwShadowHelper *self,
   gtk_widget_set_css_classes (self->outline, classes);
 }
 
-void
-adw_shadow_helper_size_allocate (AdwShadowHelper *self,
-                                 int              width,
-                                 int              height,
-                                 int              baseline,
-                                 int              x,
-                                 int              y,
-                                 double           progress,
-                                 GtkPanDirection  direction)
+static void
+resolve_style (AdwShadowHelper *self,
+               int              width,
+               int              height,
+               int              baseline,
+               GtkPanDirection  direction)
 {
-  double distance, remaining_distance;
-  double shadow_opacity;
-  int shadow_size, border_size, outline_size;
   GtkOrientation orientation;
-
-  set_style_classes (self, direction);
-
-  gtk_widget_allocate (self->dimming, width, height, baseline,
-                       gsk_transform_translate (NULL, &GRAPHENE_POINT_INIT (x, y)));
+  int length;
 
   switch (direction) {
   case GTK_PAN_DIRECTION_LEFT:
   case GTK_PAN_DIRECTION_RIGHT:
-    distance = width;
+    length = height;
     orientation = GTK_ORIENTATION_HORIZONTAL;
     break;
   case GTK_PAN_DIRECTION_UP:
   case GTK_PAN_DIRECTION_DOWN:
-    distance = height;
+    length = width;
     orientation = GTK_ORIENTATION_VERTICAL;
     break;
   default:
     g_assert_not_reached ();
   }
 
-  gtk_widget_set_visible (self->dimming, progress < 1);
-  gtk_widget_set_visible (self->shadow, progress < 1);
-  gtk_widget_set_visible (self->border, progress < 1);
-  gtk_widget_set_visible (self->outline, progress < 1);
+  if (self->style_valid &&
+      self->direction == direction &&
+      self->length == length &&
+      self->dimming_width == gtk_widget_get_width (self->widget) &&
+      self->dimming_height == gtk_widget_get_height (self->widget))
+    return;
+
+  if (self->direction != direction)
+    set_style_classes (self, direction);
+
+  self->direction = direction;
+  self->length = length;
+  self->dimming_width = gtk_widget_get_width (self->widget);
+  self->dimming_height = gtk_widget_get_height (self->widget);
+
+  gtk_widget_measure (self->shadow, orientation, -1, &self->shadow_size, NULL, NULL, NULL);
+  gtk_widget_measure (self->border, orientation, -1, &self->border_size, NULL, NULL, NULL);
+  gtk_widget_measure (self->outline, orientation, -1, &self->outline_size, NULL, NULL, NULL);
+
+  /* The gizmos stay at the origin, they are only used to render the nodes.
+   * Their backgrounds don't change along the edge, so the dimming can be
+   * rendered once for the whole widget and clipped. */
+  gtk_widget_allocate (self->dimming, self->dimming_width, self->dimming_height, baseline, NULL);
+
+  if (orientation == GTK_ORIENTATION_HORIZONTAL) {
+    gtk_widget_allocate (self->shadow, self->shadow_size, MAX (length, self->shadow_size), baseline, NULL);
+    gtk_widget_allocate (self->border, self->border_size, MAX (length, self->border_size), baseline, NULL);
+    gtk_widget_allocate (self->outline, self->outline_size, MAX (length, self->outline_size), baseline, NULL);
+  } else {
+    gtk_widget_allocate (self->shadow, MAX (length, self->shadow_size), self->shadow_size, baseline, NULL);
+    gtk_widget_allocate (self->border, MAX (length, self->border_size), self->border_size, baseline, NULL);
+    gtk_widget_allocate (self->outline, MAX (length, self->outline_size), self->outline_size, baseline, NULL);
+  }
+
+  clear_nodes (self);
+
+  self->style_valid = TRUE;
+}
+
+void
+adw_shadow_helper_size_allocate (AdwShadowHelper *self,
+                                 int              width,
+                                 int              height,
+                                 int              baseline,
+                                 int              x,
+                                 int              y,
+                                 double           progress,
+                                 GtkPanDirection  direction)
+{
+  gboolean visible = progress < 1;
+
+  if (visible != self->visible) {
+    gtk_widget_set_visible (self->dimming, visible);
+    gtk_widget_set_visible (self->shadow, visible);
+    gtk_widget_set_visible (self->border, visible);
+    gtk_widget_set_visible (self->outline, visible);
+
+    /* The style isn't updated while the gizmos are hidden */
+    self->style_valid = FALSE;
+    self->visible = visible;
+  }
+
+  self->x = x;
+  self->y = y;
+  self->width = width;
+  self->height = height;
+  self->progress = progress;
+
+  if (visible)
+    resolve_style (self, width, height, baseline, direction);
+}
+
+static GskRenderNode *
+snapshot_gizmo (AdwShadowHelper *self,
+                GtkWidget       *gizmo)
+{
+  GtkSnapshot *snapshot = gtk_snapshot_new ();
+
+  gtk_widget_snapshot_child (self->widget, gizmo, snapshot);
+
+  return gtk_snapshot_free_to_node (snapshot);
+}
+
+static void
+append_node_at (GtkSnapshot   *snapshot,
+                GskRenderNode *node,
+                int            x,
+                int            y)
+{
+  if (!node)
+    return;
+
+  gtk_snapshot_save (snapshot);
+  gtk_snapshot_translate (snapshot, &GRAPHENE_POINT_INIT (x, y));
+  gtk_snapshot_append_node (snapshot, node);
+  gtk_snapshot_restore (snapshot);
+}
+
+void
+adw_shadow_helper_snapshot (AdwShadowHelper *self,
+                            GtkSnapshot     *snapshot)
+{
+  double distance, remaining_distance, shadow_opacity;
+  int x = self->x, y = self->y;
+  int width = self->width, height = self->height;
+
+  if (!self->visible)
+    return;
+
+  if (!self->nodes_valid) {
+    self->dimming_node = snapshot_gizmo (self, self->dimming);
+    self->shadow_node = snapshot_gizmo (self, self->shadow);
+    self->border_node = snapshot_gizmo (self, self->border);
+    self->outline_node = snapshot_gizmo (self, self->outline);
+    self->nodes_valid = TRUE;
+  }
 
-  gtk_widget_measure (self->shadow, orientation, -1, &shadow_size, NULL, NULL, NULL);
-  gtk_widget_measure (self->border, orientation, -1, &border_size, NULL, NULL, NULL);
-  gtk_widget_measure (self->outline, orientation, -1, &outline_size, NULL, NULL, NULL);
+  if (self->direction == GTK_PAN_DIRECTION_LEFT ||
+      self->direction == GTK_PAN_DIRECTION_RIGHT)
+    distance = width;
+  else
+    distance = height;
 
-  remaining_distance = (1 - progress) * (double) distance;
-  if (remaining_distance < shadow_size)
-    shadow_opacity = (remaining_distance / shadow_size);
+  remaining_distance = (1 - self->progress) * distance;
+  if (remaining_distance < self->shadow_size)
+    shadow_opacity = (remaining_distance / self->shadow_size);
   else
     shadow_opacity = 1;
 
-  gtk_widget_set_opacity (self->dimming, 1 - progress);
-  gtk_widget_set_opacity (self->shadow, shadow_opacity);
+  if (self->dimming_node) {
+    gtk_snapshot_push_clip (snapshot, &GRAPHENE_RECT_INIT (x, y, width, height));
+    gtk_snapshot_push_opacity (snapshot, 1 - self->progress);
+    gtk_snapshot_append_node (snapshot, self->dimming_node);
+    gtk_snapshot_pop (snapshot);
+    gtk_snapshot_pop (snapshot);
+  }
 
-  switch (direction) {
+  gtk_snapshot_push_opacity (snapshot, shadow_opacity);
+
+  switch (self->direction) {
   case GTK_PAN_DIRECTION_LEFT:
-    gtk_widget_allocate (self->shadow, shadow_size, MAX (height, shadow_size), baseline,
-                         gsk_transform_translate (NULL, &GRAPHENE_POINT_INIT (x, y)));
-    gtk_widget_allocate (self->border, border_size, MAX (height, border_size), baseline,
-                         gsk_transform_translate (NULL, &GRAPHENE_POINT_INIT (x, y)));
-    gtk_widget_allocate (self->outline, outline_size, MAX (height, outline_size), baseline,
-                         gsk_transform_translate (NULL, &GRAPHENE_POINT_INIT (x - outline_size, y)));
+    append_node_at (snapshot, self->shadow_node, x, y);
     break;
   case GTK_PAN_DIRECTION_RIGHT:
-    gtk_widget_allocate (self->shadow, shadow_size, MAX (height, shadow_size), baseline,
-                         gsk_transform_translate (NULL, &GRAPHENE_POINT_INIT (x + width - shadow_size, y)));
-    gtk_widget_allocate (self->border, border_size, MAX (height, border_size), baseline,
-                         gsk_transform_translate (NULL, &GRAPHENE_POINT_INIT (x + width - border_size, y)));
-    gtk_widget_allocate (self->outline, outline_size, MAX (height, outline_size), baseline,
-                         gsk_transform_translate (NULL, &GRAPHENE_POINT_INIT (x + width, y)));
+    append_node_at (snapshot, self->shadow_node, x + width - self->shadow_size, y);
     break;
   case GTK_PAN_DIRECTION_UP:
-    gtk_widget_allocate (self->shadow, MAX (width, shadow_size), shadow_size, baseline,
-                         gsk_transform_translate (NULL, &GRAPHENE_POINT_INIT (x, y)));
-    gtk_widget_allocate (self->border, MAX (width, border_size), border_size, baseline,
-                         gsk_transform_translate (NULL, &GRAPHENE_POINT_INIT (x, y)));
-    gtk_widget_allocate (self->outline, MAX (width, outline_size), outline_size, baseline,
-                         gsk_transform_translate (NULL, &GRAPHENE_POINT_INIT (x, y - outline_size)));
+    append_node_at (snapshot, self->shadow_node, x, y);
     break;
   case GTK_PAN_DIRECTION_DOWN:
-    gtk_widget_allocate (self->shadow, MAX (width, shadow_size), shadow_size, baseline,
-                         gsk_transform_translate (NULL, &GRAPHENE_POINT_INIT (x, y + height - shadow_size)));
-    gtk_widget_allocate (self->border, MAX (width, border_size), border_size, baseline,
-                         gsk_transform_translate (NULL, &GRAPHENE_POINT_INIT (x, y + height - border_size)));
-    gtk_widget_allocate (self->outline, MAX (width, outline_size), outline_size, baseline,
-                         gsk_transform_translate (NULL, &GRAPHENE_POINT_INIT (x, y + height)));
+    append_node_at (snapshot, self->shadow_node, x, y + height - self->shadow_size);
     break;
   default:
     g_assert_not_reached ();
   }
-}
 
-void
-adw_shadow_helper_snapshot (AdwShadowHelper *self,
-                            GtkSnapshot     *snapshot)
-{
-  if (!gtk_widget_get_child_visible (self->dimming))
-    return;
+  gtk_snapshot_pop (snapshot);
 
-  gtk_widget_snapshot_child (self->widget, self->dimming, snapshot);
-  gtk_widget_snapshot_child (self->widget, self->shadow, snapshot);
-  gtk_widget_snapshot_child (self->widget, self->border, snapshot);
-  gtk_widget_snapshot_child (self->widget, self->outline, snapshot);
+  switch (self->direction) {
+  case GTK_PAN_DIRECTION_LEFT:
+    append_node_at (snapshot, self->border_node, x, y);
+    append_node_at (snapshot, self->outline_node, x - self->outline_size, y);
+    break;
+  case GTK_PAN_DIRECTION_RIGHT:
+    append_node_at (snapshot, self->border_node, x + width - self->border_size, y);
+    append_node_at (snapshot, self->outline_node, x + width, y);
+    break;
+  case GTK_PAN_DIRECTION_UP:
+    append_node_at (snapshot, self->border_node, x, y);
+    append_node_at (snapshot, self->outline_node, x, y - self->outline_size);
+    break;
+  case GTK_PAN_DIRECTION_DOWN:
+    append_node_at (snapshot, self->border_node, x, y + height - self->border_size);
+    append_node_at (snapshot, self->outline_node, x, y + height);
+    break;
+  default:
+    g_assert_not_reached ();
+  }
 }
@@ -59,6 +59,11 @@ struct _AdwStyleManager
 
   GtkCssProvider *animations_provider;
   guint animation_timeout_id;
+
+  gboolean stylesheet_loaded;
+  gboolean loaded_dark;
+  gboolean loaded_high_contrast;
+  char *loaded_yaru_accent;
 };
 
 G_DEFINE_FINAL_TYPE (AdwStyleManager, adw_style_manager, G_TYPE_OBJECT);
@@ -127,15 +132,53 @@ enable_animations_cb (AdwStyleManager *self)
   self->animation_timeout_id = 0;
 }
 
+static void
+update_prefer_dark_theme (AdwStyleManager *self)
+{
+  GtkSettings *gtk_settings = gtk_settings_get_for_display (self->display);
+  gboolean prefer_dark_theme;
+
+  /* Changing this makes GTK reparse the theme, so only do it if needed */
+  g_object_get (gtk_settings,
+                "gtk-application-prefer-dark-theme", &prefer_dark_theme,
+                NULL);
+
+  if (!prefer_dark_theme == !self->dark)
+    return;
+
+  self->setting_dark = TRUE;
+
+  g_object_set (gtk_settings,
+                "gtk-application-prefer-dark-theme", self->dark,
+                NULL);
+
+  self->setting_dark = FALSE;
+}
+
 static void
 update_stylesheet (AdwStyleManager *self)
 {
-  GtkSettings *gtk_settings;
+  gboolean high_contrast;
+  const char *yaru_accent;
 
   if (!self->display)
     return;
 
-  gtk_settings = gtk_settings_get_for_display (self->display);
+  high_contrast = adw_settings_get_high_contrast (self->settings);
+  yaru_accent = adw_settings_get_yaru_accent (self->settings);
+
+  /* Every switch invalidates the CSS cascade, so don't do anything unless
+   * the variant has actually changed */
+  if (self->stylesheet_loaded &&
+      self->loaded_dark == self->dark &&
+      self->loaded_high_contrast == high_contrast &&
+      !g_strcmp0 (self->loaded_yaru_accent, yaru_accent))
+    return;
+
+  self->stylesheet_loaded = TRUE;
+  self->loaded_dark = self->dark;
+  self->loaded_high_contrast = high_contrast;
+  g_set_str (&self->loaded_yaru_accent, yaru_accent);
 
   if (self->animation_timeout_id)
     g_clear_handle_id (&self->animation_timeout_id, g_source_remove);
@@ -144,19 +187,13 @@ update_stylesheet (AdwStyleManager *self)
                                               GTK_STYLE_PROVIDER (self->animations_provider),
                                               10000);
 
-  self->setting_dark = TRUE;
-
-  g_object_set (gtk_settings,
-                "gtk-application-prefer-dark-theme", self->dark,
-                NULL);
-
-  self->setting_dark = FALSE;
+  update_prefer_dark_theme (self);
 
   if (self->provider) {
-    if (adw_settings_get_high_contrast (self->settings))
+    if (high_contrast)
       gtk_css_provider_load_from_resource (self->provider,
                                            "/org/gnome/Advaita/styles/base-hc.css");
-    else if (adw_settings_get_yaru_accent (self->settings))
+    else if (yaru_accent)
       gtk_css_provider_load_from_resource (self->provider,
                                            "/org/gnome/Advaita/styles/base-yaru.css");
     else
@@ -173,25 +210,21 @@ update_stylesheet (AdwStyleManager *self)
     else
       variant = g_strdup ("defaults-light");
 
-    if (!adw_settings_get_high_contrast (self->settings)) {
-      const char *yaru_accent = adw_settings_get_yaru_accent (self->settings);
-
-      if (yaru_accent) {
-        g_autoptr (GFile) gresource = NULL;
-        g_autofree char *base_variant = g_steal_pointer (&variant);
-        g_autofree char *yaru_variant = NULL;
-        g_autofree char *resource_uri = NULL;
-
-        yaru_variant = g_strdup_printf ("%s-yaru-%s", base_variant, yaru_accent);
-        resource_uri = g_strdup_printf ("resource:///org/gnome/Advaita/styles/%s.css", yaru_variant);
-        gresource = g_file_new_for_uri (resource_uri);
-
-        if (g_file_query_exists (gresource, NULL)) {
-          variant = g_steal_pointer (&yaru_variant);
-        } else {
-          variant = g_steal_pointer (&base_variant);
-          g_warning ("No known Yaru accent '%s'", yaru_accent);
-        }
+    if (!high_contrast && yaru_accent) {
+      g_autoptr (GFile) gresource = NULL;
+      g_autofree char *base_variant = g_steal_pointer (&variant);
+      g_autofree char *yaru_variant = NULL;
+      g_autofree char *resource_uri = NULL;
+
+      yaru_variant = g_strdup_printf ("%s-yaru-%s", base_variant, yaru_accent);
+      resource_uri = g_strdup_printf ("resource:///org/gnome/Advaita/styles/%s.css", yaru_variant);
+      gresource = g_file_new_for_uri (resource_uri);
+
+      if (g_file_query_exists (gresource, NULL)) {
+        variant = g_steal_pointer (&yaru_variant);
+      } else {
+        variant = g_steal_pointer (&base_variant);
+        g_warning ("No known Yaru accent '%s'", yaru_accent);
       }
     }
 
@@ -331,6 +364,7 @@ adw_style_manager_dispose (GObject *object)
   g_clear_object (&self->provider);
   g_clear_object (&self->colors_provider);
   g_clear_object (&self->animations_provider);
+  g_clear_pointer (&self->loaded_yaru_accent, g_free);
 
   G_OBJECT_CLASS (adw_style_manager_parent_class)->dispose (object);
 }
@@ -18,4 +18,58 @@ G_BEGIN_DECLS
 
 void adw_swipe_tracker_reset (AdwSwipeTracker *self);
 
+/* Must be a power of two */
+#define ADW_SWIPE_HISTORY_SIZE 256
+
+typedef struct {
+  double delta;
+  guint32 time;
+} AdwSwipeHistoryRecord;
+
+/* A ring buffer of the recent gesture deltas. When it's full, the oldest
+ * records are overwritten. */
+typedef struct {
+  AdwSwipeHistoryRecord records[ADW_SWIPE_HISTORY_SIZE];
+  guint start;
+  guint len;
+} AdwSwipeHistory;
+
+ADW_AVAILABLE_IN_ALL
+void   adw_swipe_history_clear        (AdwSwipeHistory *history);
+ADW_AVAILABLE_IN_ALL
+void   adw_swipe_history_trim         (AdwSwipeHistory *history,
+                                       guint32          current_time);
+ADW_AVAILABLE_IN_ALL
+void   adw_swipe_history_append       (AdwSwipeHistory *history,
+                                       double           delta,
+                                       guint32          time);
+ADW_AVAILABLE_IN_ALL
+double adw_swipe_history_get_velocity (AdwSwipeHistory *history);
+
+typedef enum {
+  ADW_SWIPE_EVENT_DRAG_BEGIN,
+  ADW_SWIPE_EVENT_DRAG_UPDATE,
+  ADW_SWIPE_EVENT_DRAG_END,
+  ADW_SWIPE_EVENT_DRAG_CANCEL,
+  ADW_SWIPE_EVENT_SCROLL,
+  ADW_SWIPE_EVENT_SCROLL_STOP,
+} AdwSwipeEventType;
+
+typedef struct {
+  AdwSwipeEventType type;
+  guint32 time;
+  double x;
+  double y;
+} AdwSwipeEvent;
+
+ADW_AVAILABLE_IN_ALL
+AdwSwipeTracker *adw_swipe_tracker_get_for_swipeable (AdwSwipeable *swipeable);
+
+ADW_AVAILABLE_IN_ALL
+void    adw_swipe_tracker_feed_event (AdwSwipeTracker     *self,
+                                      const AdwSwipeEvent *event);
+ADW_AVAILABLE_IN_ALL
+GArray *adw_swipe_events_parse       (const char           *contents,
+                                      GError              **error);
+
 G_END_DECLS
@@ -11,6 +11,8 @@
 #include "adw-marshalers.h"
 #include "adw-navigation-direction.h"
 
+#include <errno.h>
+#include <glib/gstdio.h>
 #include <math.h>
 
 #define TOUCHPAD_BASE_DISTANCE_H 400
@@ -56,11 +58,6 @@ typedef enum {
   ADW_SWIPE_TRACKER_STATE_REJECTED,
 } AdwSwipeTrackerState;
 
-typedef struct {
-  double delta;
-  guint32 time;
-} EventHistoryRecord;
-
 struct _AdwSwipeTracker
 {
   GObject parent_instance;
@@ -78,7 +75,11 @@ struct _AdwSwipeTracker
   double pointer_x;
   double pointer_y;
 
-  GArray *event_history;
+  AdwSwipeHistory event_history;
+
+  /* Cached for the duration of a gesture */
+  double *snap_points;
+  int n_snap_points;
 
   double initial_progress;
   double progress;
@@ -94,6 +95,11 @@ struct _AdwSwipeTracker
   GtkGesture *touch_gesture_capture;
 
   gboolean is_window_handle;
+
+  /* Replayed drags, see adw_swipe_tracker_feed_event() */
+  gboolean replay_drag_active;
+  double replay_start_x;
+  double replay_start_y;
 };
 
 G_DEFINE_FINAL_TYPE_WITH_CODE (AdwSwipeTracker, adw_swipe_tracker, G_TYPE_OBJECT,
@@ -144,17 +150,24 @@ set_swipeable (AdwSwipeTracker *self,
   if (self->swipeable == swipeable)
     return;
 
-  if (self->swipeable)
+  if (self->swipeable) {
+    if (g_object_get_data (G_OBJECT (self->swipeable), "-adw-swipe-tracker") == self)
+      g_object_set_data (G_OBJECT (self->swipeable), "-adw-swipe-tracker", NULL);
+
     g_object_weak_unref (G_OBJECT (self->swipeable),
                          (GWeakNotify) swipeable_notify_cb,
                          self);
+  }
 
   self->swipeable = swipeable;
 
-  if (self->swipeable)
+  if (self->swipeable) {
+    g_object_set_data (G_OBJECT (self->swipeable), "-adw-swipe-tracker", self);
+
     g_object_weak_ref (G_OBJECT (self->swipeable),
                        (GWeakNotify) swipeable_notify_cb,
                        self);
+  }
 }
 
 static void
@@ -167,11 +180,26 @@ reset (AdwSwipeTracker *self)
   self->initial_progress = 0;
   self->progress = 0;
 
-  g_array_remove_range (self->event_history, 0, self->event_history->len);
+  adw_swipe_history_clear (&self->event_history);
+
+  g_clear_pointer (&self->snap_points, g_free);
 
   self->cancelled = FALSE;
 }
 
+static double *
+get_snap_points (AdwSwipeTracker *self,
+                 int             *n_snap_points)
+{
+  if (!self->snap_points)
+    self->snap_points = adw_swipeable_get_snap_points (self->swipeable,
+                                                       &self->n_snap_points);
+
+  *n_snap_points = self->n_snap_points;
+
+  return self->snap_points;
+}
+
 static void
 get_range (AdwSwipeTracker *self,
            double          *first,
@@ -180,12 +208,10 @@ get_range (AdwSwipeTracker *self,
   double *points;
   int n;
 
-  points = adw_swipeable_get_snap_points (self->swipeable, &n);
+  points = get_snap_points (self, &n);
 
   *first = points[0];
   *last = points[n - 1];
-
-  g_free (points);
 }
 
 static void
@@ -197,6 +223,9 @@ gesture_prepare (AdwSwipeTracker        *self,
 
   g_signal_emit (self, signals[SIGNAL_PREPARE], 0, direction);
 
+  /* The swipeable may have updated its snap points for this gesture */
+  g_clear_pointer (&self->snap_points, g_free);
+
   self->initial_progress = adw_swipeable_get_progress (self->swipeable);
   self->progress = self->initial_progress;
   self->state = ADW_SWIPE_TRACKER_STATE_PENDING;
@@ -275,23 +304,108 @@ adjust_for_overshoot (AdwSwipeTracker *self,
   return (1 - 1 / (1 + amount * d)) / d;
 }
 
-static void
-trim_history (AdwSwipeTracker *self,
-              guint32          current_time)
+static inline AdwSwipeHistoryRecord *
+get_history_record (AdwSwipeHistory *history,
+                    guint            i)
 {
-  guint32 threshold_time = current_time - EVENT_HISTORY_THRESHOLD_MS;
-  guint i;
+  return &history->records[(history->start + i) & (ADW_SWIPE_HISTORY_SIZE - 1)];
+}
+
+void
+adw_swipe_history_clear (AdwSwipeHistory *history)
+{
+  history->start = 0;
+  history->len = 0;
+}
 
-  for (i = 0; i < self->event_history->len; i++) {
-    guint32 time = g_array_index (self->event_history,
-                                  EventHistoryRecord, i).time;
+void
+adw_swipe_history_trim (AdwSwipeHistory *history,
+                        guint32          current_time)
+{
+  while (history->len > 0) {
+    guint32 time = get_history_record (history, 0)->time;
 
-    if (time >= threshold_time)
+    /* Signed difference, so that this works across the wraparound */
+    if ((gint32) (current_time - time) <= EVENT_HISTORY_THRESHOLD_MS)
       break;
+
+    history->start = (history->start + 1) & (ADW_SWIPE_HISTORY_SIZE - 1);
+    history->len--;
   }
+}
 
-  if (i > 0)
-    g_array_remove_range (self->event_history, 0, i);
+void
+adw_swipe_history_append (AdwSwipeHistory *history,
+                          double           delta,
+                          guint32          time)
+{
+  AdwSwipeHistoryRecord *record;
+
+  adw_swipe_history_trim (history, time);
+
+  if (history->len == ADW_SWIPE_HISTORY_SIZE) {
+    history->start = (history->start + 1) & (ADW_SWIPE_HISTORY_SIZE - 1);
+    history->len--;
+  }
+
+  record = get_history_record (history, history->len++);
+  record->delta = delta;
+  record->time = time;
+}
+
+/*
+ * Fits a line to the position over time with weighted least squares, and
+ * returns its slope. Newer records weigh up to twice as much as the ones
+ * about to be trimmed, so the result follows the end of the gesture while
+ * still smoothing out the jitter of high frequency devices.
+ *
+ * The delta of the first record is what led to its position, so it's not
+ * counted. With two records, this is the same as the average velocity.
+ */
+double
+adw_swipe_history_get_velocity (AdwSwipeHistory *history)
+{
+  double sum_w = 0, sum_t = 0, sum_p = 0, sum_tt = 0, sum_tp = 0;
+  double pos = 0, denominator;
+  guint32 first_time, last_time;
+  guint i;
+
+  if (history->len < 2)
+    return 0;
+
+  first_time = get_history_record (history, 0)->time;
+  last_time = get_history_record (history, history->len - 1)->time;
+
+  for (i = 0; i < history->len; i++) {
+    AdwSwipeHistoryRecord *r = get_history_record (history, i);
+    double t = (gint32) (r->time - first_time);
+    double age = (gint32) (last_time - r->time);
+    double w = 1.0 - CLAMP (age / (2.0 * EVENT_HISTORY_THRESHOLD_MS), 0.0, 0.5);
+
+    if (i > 0)
+      pos += r->delta;
+
+    sum_w += w;
+    sum_t += w * t;
+    sum_p += w * pos;
+    sum_tt += w * t * t;
+    sum_tp += w * t * pos;
+  }
+
+  denominator = sum_w * sum_tt - sum_t * sum_t;
+
+  /* All records have the same time */
+  if (denominator < EPSILON)
+    return 0;
+
+  return (sum_w * sum_tp - sum_t * sum_p) / denominator;
+}
+
+static void
+trim_history (AdwSwipeTracker *self,
+              guint32          current_time)
+{
+  adw_swipe_history_trim (&self->event_history, current_time);
 }
 
 static void
@@ -299,45 +413,24 @@ append_to_history (AdwSwipeTracker *self,
                    double           delta,
                    guint32          time)
 {
-  EventHistoryRecord record;
-
-  trim_history (self, time);
-
-  record.delta = delta;
-  record.time = time;
-
-  g_array_append_val (self->event_history, record);
+  adw_swipe_history_append (&self->event_history, delta, time);
 }
 
 static double
 calculate_velocity (AdwSwipeTracker *self)
 {
-  double total_delta = 0, velocity, lower, upper;
+  double velocity, lower, upper;
   double *points;
-  guint32 first_time = 0, last_time = 0;
-  guint i;
   int n;
 
-  for (i = 0; i < self->event_history->len; i++) {
-    EventHistoryRecord *r =
-      &g_array_index (self->event_history, EventHistoryRecord, i);
-
-    if (i == 0)
-      first_time = r->time;
-    else
-      total_delta += r->delta;
-
-    last_time = r->time;
-  }
+  velocity = adw_swipe_history_get_velocity (&self->event_history);
 
-  if (first_time == last_time)
+  if (G_APPROX_VALUE (velocity, 0, DBL_EPSILON))
     return 0;
 
-  velocity = total_delta / (last_time - first_time);
-
   /* Overshoot */
 
-  points = adw_swipeable_get_snap_points (self->swipeable, &n);
+  points = get_snap_points (self, &n);
 
   if (!self->allow_long_swipes)
     get_bounds (self, points, n, self->initial_progress, &lower, &upper);
@@ -370,6 +463,9 @@ gesture_begin (AdwSwipeTracker *self)
   self->state = ADW_SWIPE_TRACKER_STATE_SCROLLING;
 
   g_signal_emit (self, signals[SIGNAL_BEGIN_SWIPE], 0);
+
+  /* Same as in gesture_prepare() */
+  g_clear_pointer (&self->snap_points, g_free);
 }
 
 static int
@@ -404,10 +500,8 @@ gesture_update (AdwSwipeTracker *self,
     double *points;
     int n;
 
-    points = adw_swipeable_get_snap_points (self->swipeable, &n);
+    points = get_snap_points (self, &n);
     get_bounds (self, points, n, self->initial_progress, &lower, &upper);
-
-    g_free (points);
   } else {
     get_range (self, &lower, &upper);
   }
@@ -446,7 +540,7 @@ get_end_progress (AdwSwipeTracker *self,
   if (self->cancelled)
     return adw_swipeable_get_cancel_progress (self->swipeable);
 
-  points = adw_swipeable_get_snap_points (self->swipeable, &n);
+  points = get_snap_points (self, &n);
 
   if (!self->allow_long_swipes)
     get_bounds (self, points, n, self->initial_progress, &lower, &upper);
@@ -457,8 +551,6 @@ get_end_progress (AdwSwipeTracker *self,
     pos = points[find_closest_point (points, n, self->progress)];
     pos = CLAMP (pos, lower, upper);
 
-    g_free (points);
-
     return pos;
   }
 
@@ -481,8 +573,6 @@ get_end_progress (AdwSwipeTracker *self,
   pos = CLAMP (pos, lower, upper);
   pos = points[find_point_for_projection (self, points, n, pos, velocity)];
 
-  g_free (points);
-
   return pos;
 }
 
@@ -575,6 +665,72 @@ is_in_swipe_area (AdwSwipeTracker        *self,
          y < rect.y + rect.height;
 }
 
+static const char * const event_names[] = {
+  [ADW_SWIPE_EVENT_DRAG_BEGIN] = "drag-begin",
+  [ADW_SWIPE_EVENT_DRAG_UPDATE] = "drag-update",
+  [ADW_SWIPE_EVENT_DRAG_END] = "drag-end",
+  [ADW_SWIPE_EVENT_DRAG_CANCEL] = "drag-cancel",
+  [ADW_SWIPE_EVENT_SCROLL] = "scroll",
+  [ADW_SWIPE_EVENT_SCROLL_STOP] = "scroll-stop",
+};
+
+static FILE *
+get_recording_file (void)
+{
+  static FILE *file = NULL;
+  static gsize initialized = 0;
+
+  if (g_once_init_enter (&initialized)) {
+    const char *path = g_getenv ("ADW_SWIPE_RECORD");
+
+    if (path && *path) {
+      file = g_fopen (path, "a");
+
+      if (!file)
+        g_warning ("Couldn't open %s for recording swipes: %s",
+                   path, g_strerror (errno));
+    }
+
+    g_once_init_leave (&initialized, 1);
+  }
+
+  return file;
+}
+
+/* Appends the event to the file in ADW_SWIPE_RECORD, in the format
+ * adw_swipe_events_parse() reads */
+static void
+record_event (AdwSwipeTracker   *self,
+              AdwSwipeEventType  type,
+              guint32            time,
+              double             x,
+              double             y)
+{
+  static AdwSwipeTracker *last_tracker = NULL;
+  char x_str[G_ASCII_DTOSTR_BUF_SIZE];
+  char y_str[G_ASCII_DTOSTR_BUF_SIZE];
+  FILE *file = get_recording_file ();
+
+  if (G_LIKELY (!file))
+    return;
+
+  if (last_tracker != self) {
+    fprintf (file, "# %s %p\n", G_OBJECT_TYPE_NAME (self->swipeable), self->swipeable);
+    last_tracker = self;
+  }
+
+  fprintf (file, "%s %u %s %s\n",
+           event_names[type],
+           time,
+           g_ascii_dtostr (x_str, sizeof (x_str), x),
+           g_ascii_dtostr (y_str, sizeof (y_str), y));
+
+  if (type == ADW_SWIPE_EVENT_DRAG_END ||
+      type == ADW_SWIPE_EVENT_DRAG_CANCEL ||
+      type == ADW_SWIPE_EVENT_SCROLL_STOP)
+    fflush (file);
+}
+
 static void
 drag_capture_begin_cb (AdwSwipeTracker *self,
                        double           start_x,
@@ -628,17 +784,22 @@ drag_begin_cb (AdwSwipeTracker *self,
   }
 
   gtk_gesture_set_state (self->touch_gesture_capture, GTK_EVENT_SEQUENCE_DENIED);
+
+  record_event (self, ADW_SWIPE_EVENT_DRAG_BEGIN,
+                gtk_event_controller_get_current_event_time (GTK_EVENT_CONTROLLER (gesture)),
+                start_x, start_y);
 }
 
-static void
-drag_update_cb (AdwSwipeTracker *self,
-                double           offset_x,
-                double           offset_y,
-                GtkGestureDrag  *gesture)
+static GtkEventSequenceState
+handle_drag_update (AdwSwipeTracker *self,
+                    double           start_x,
+                    double           start_y,
+                    double           offset_x,
+                    double           offset_y,
+                    guint32          time)
 {
   double offset, distance, delta;
   gboolean is_vertical, is_offset_vertical;
-  guint32 time;
 
   distance = adw_swipeable_get_distance (self->swipeable);
 
@@ -653,21 +814,17 @@ drag_update_cb (AdwSwipeTracker *self,
 
   is_offset_vertical = (ABS (offset_y) > ABS (offset_x));
 
-  if (self->state == ADW_SWIPE_TRACKER_STATE_REJECTED) {
-    gtk_gesture_set_state (GTK_GESTURE (gesture), GTK_EVENT_SEQUENCE_DENIED);
-    return;
-  }
-
-  time = gtk_event_controller_get_current_event_time (GTK_EVENT_CONTROLLER (gesture));
+  if (self->state == ADW_SWIPE_TRACKER_STATE_REJECTED)
+    return GTK_EVENT_SEQUENCE_DENIED;
 
   append_to_history (self, delta, time);
 
   if (self->state == ADW_SWIPE_TRACKER_STATE_NONE) {
-    if (is_vertical == is_offset_vertical)
-      gesture_prepare (self, offset > 0 ? ADW_NAVIGATION_DIRECTION_FORWARD : ADW_NAVIGATION_DIRECTION_BACK);
-    else
-      gtk_gesture_set_state (GTK_GESTURE (gesture), GTK_EVENT_SEQUENCE_DENIED);
-    return;
+    if (is_vertical != is_offset_vertical)
+      return GTK_EVENT_SEQUENCE_DENIED;
+
+    gesture_prepare (self, offset > 0 ? ADW_NAVIGATION_DIRECTION_FORWARD : ADW_NAVIGATION_DIRECTION_BACK);
+    return GTK_EVENT_SEQUENCE_NONE;
   }
 
   if (self->state == ADW_SWIPE_TRACKER_STATE_PENDING) {
@@ -691,26 +848,20 @@ drag_update_cb (AdwSwipeTracker *self,
 
     if (G_APPROX_VALUE (drag_distance, threshold, DBL_EPSILON) ||
         drag_distance > threshold) {
-      double start_x, start_y;
       AdwNavigationDirection direction;
       gboolean is_overshooting_lower, is_overshooting_upper;
 
-      gtk_gesture_drag_get_start_point (gesture, &start_x, &start_y);
       direction = offset > 0 ? ADW_NAVIGATION_DIRECTION_FORWARD : ADW_NAVIGATION_DIRECTION_BACK;
 
       if (!is_in_swipe_area (self, start_x, start_y, direction, TRUE) &&
           !is_in_swipe_area (self, start_x + offset_x, start_y + offset_y, direction, TRUE))
-        return;
+        return GTK_EVENT_SEQUENCE_NONE;
 
-      if (is_vertical != is_offset_vertical) {
-        gtk_gesture_set_state (GTK_GESTURE (gesture), GTK_EVENT_SEQUENCE_DENIED);
-        return;
-      }
+      if (is_vertical != is_offset_vertical)
+        return GTK_EVENT_SEQUENCE_DENIED;
 
-      if (G_APPROX_VALUE (first_point, last_point, DBL_EPSILON)) {
-        gtk_gesture_set_state (GTK_GESTURE (gesture), GTK_EVENT_SEQUENCE_DENIED);
-        return;
-      }
+      if (G_APPROX_VALUE (first_point, last_point, DBL_EPSILON))
+        return GTK_EVENT_SEQUENCE_DENIED;
 
       is_overshooting_lower =
         offset < 0 &&
@@ -723,49 +874,95 @@ drag_update_cb (AdwSwipeTracker *self,
          self->progress > last_point);
 
       if ((!self->lower_overshoot && is_overshooting_lower) ||
-          (!self->upper_overshoot && is_overshooting_upper)) {
-        gtk_gesture_set_state (GTK_GESTURE (gesture), GTK_EVENT_SEQUENCE_DENIED);
-        return;
-      }
+          (!self->upper_overshoot && is_overshooting_upper))
+        return GTK_EVENT_SEQUENCE_DENIED;
 
       gesture_begin (self);
 
       self->prev_offset = offset;
-      gtk_gesture_set_state (GTK_GESTURE (gesture), GTK_EVENT_SEQUENCE_CLAIMED);
+
+      gesture_update (self, delta / distance, time);
+
+      return GTK_EVENT_SEQUENCE_CLAIMED;
     }
   }
 
   if (self->state == ADW_SWIPE_TRACKER_STATE_SCROLLING)
     gesture_update (self, delta / distance, time);
+
+  return GTK_EVENT_SEQUENCE_NONE;
 }
 
-static void
-drag_end_cb (AdwSwipeTracker *self,
-             double           offset_x,
-             double           offset_y,
-             GtkGestureDrag  *gesture)
+/* Returns whether the drag sequence should be denied */
+static gboolean
+handle_drag_end (AdwSwipeTracker *self,
+                 guint32          time)
 {
   double distance;
-  guint32 time;
 
   distance = adw_swipeable_get_distance (self->swipeable);
 
   if (self->state == ADW_SWIPE_TRACKER_STATE_REJECTED) {
-    gtk_gesture_set_state (self->touch_gesture, GTK_EVENT_SEQUENCE_DENIED);
-
     reset (self);
-    return;
+    return TRUE;
   }
 
-  time = gtk_event_controller_get_current_event_time (GTK_EVENT_CONTROLLER (gesture));
-
   if (self->state != ADW_SWIPE_TRACKER_STATE_SCROLLING) {
     gesture_cancel (self, distance, time, FALSE);
-    gtk_gesture_set_state (self->touch_gesture, GTK_EVENT_SEQUENCE_DENIED);
-    return;
+    return TRUE;
   }
 
   gesture_end (self, distance, time, FALSE);
+
+  return FALSE;
+}
+
+static void
+handle_drag_cancel (AdwSwipeTracker *self,
+                    guint32          time)
+{
+  double distance;
+
+  distance = adw_swipeable_get_distance (self->swipeable);
+
+  gesture_cancel (self, distance, time, FALSE);
+}
+
+static void
+drag_update_cb (AdwSwipeTracker *self,
+                double           offset_x,
+                double           offset_y,
+                GtkGestureDrag  *gesture)
+{
+  GtkEventSequenceState state;
+  double start_x, start_y;
+  guint32 time;
+
+  time = gtk_event_controller_get_current_event_time (GTK_EVENT_CONTROLLER (gesture));
+  gtk_gesture_drag_get_start_point (gesture, &start_x, &start_y);
+
+  record_event (self, ADW_SWIPE_EVENT_DRAG_UPDATE, time, offset_x, offset_y);
+
+  state = handle_drag_update (self, start_x, start_y, offset_x, offset_y, time);
+
+  if (state != GTK_EVENT_SEQUENCE_NONE)
+    gtk_gesture_set_state (GTK_GESTURE (gesture), state);
+}
+
+static void
+drag_end_cb (AdwSwipeTracker *self,
+             double           offset_x,
+             double           offset_y,
+             GtkGestureDrag  *gesture)
+{
+  guint32 time;
+
+  time = gtk_event_controller_get_current_event_time (GTK_EVENT_CONTROLLER (gesture));
+
+  record_event (self, ADW_SWIPE_EVENT_DRAG_END, time, offset_x, offset_y);
+
+  if (handle_drag_end (self, time))
+    gtk_gesture_set_state (self->touch_gesture, GTK_EVENT_SEQUENCE_DENIED);
 }
 
 static void
@@ -774,47 +971,34 @@ drag_cancel_cb (AdwSwipeTracker  *self,
                 GtkGesture       *gesture)
 {
   guint32 time;
-  double distance;
-
-  distance = adw_swipeable_get_distance (self->swipeable);
 
   time = gtk_event_controller_get_current_event_time (GTK_EVENT_CONTROLLER (gesture));
 
-  gesture_cancel (self, distance, time, FALSE);
+  record_event (self, ADW_SWIPE_EVENT_DRAG_CANCEL, time, 0, 0);
+
+  handle_drag_cancel (self, time);
   gtk_gesture_set_state (gesture, GTK_EVENT_SEQUENCE_DENIED);
 }
 
 static gboolean
-handle_scroll_event (AdwSwipeTracker *self,
-                     GdkEvent        *event)
+handle_scroll (AdwSwipeTracker *self,
+               double           dx,
+               double           dy,
+               gboolean         is_stop,
+               guint32          time)
 {
-  GdkDevice *source_device;
-  GdkInputSource input_source;
-  double dx, dy, delta, distance;
+  double delta, distance;
   gboolean is_vertical;
-  guint32 time;
 
   is_vertical = (self->orientation == GTK_ORIENTATION_VERTICAL);
   distance = is_vertical ? TOUCHPAD_BASE_DISTANCE_V : TOUCHPAD_BASE_DISTANCE_H;
 
-  if (!event || gdk_event_get_event_type (event) != GDK_SCROLL)
-    return GDK_EVENT_PROPAGATE;
-
-  if (gdk_scroll_event_get_direction (event) != GDK_SCROLL_SMOOTH)
-    return GDK_EVENT_PROPAGATE;
-
-  source_device = gdk_event_get_device (event);
-  input_source = gdk_device_get_source (source_device);
-  if (input_source != GDK_SOURCE_TOUCHPAD)
-    return GDK_EVENT_PROPAGATE;
-
-  gdk_scroll_event_get_deltas (event, &dx, &dy);
   delta = is_vertical ? dy : dx;
   if (self->reversed)
     delta = -delta;
 
   if (self->state == ADW_SWIPE_TRACKER_STATE_REJECTED) {
-    if (gdk_scroll_event_is_stop (event))
+    if (is_stop)
       reset (self);
 
     return GDK_EVENT_PROPAGATE;
@@ -823,7 +1007,7 @@ handle_scroll_event (AdwSwipeTracker *self,
   if (self->state == ADW_SWIPE_TRACKER_STATE_NONE) {
     AdwNavigationDirection direction;
 
-    if (gdk_scroll_event_is_stop (event))
+    if (is_stop)
       return GDK_EVENT_PROPAGATE;
 
     direction = delta > 0 ? ADW_NAVIGATION_DIRECTION_FORWARD : ADW_NAVIGATION_DIRECTION_BACK;
@@ -836,8 +1020,6 @@ handle_scroll_event (AdwSwipeTracker *self,
     gesture_prepare (self, delta > 0 ? ADW_NAVIGATION_DIRECTION_FORWARD : ADW_NAVIGATION_DIRECTION_BACK);
   }
 
-  time = gdk_event_get_time (event);
-
   if (self->state == ADW_SWIPE_TRACKER_STATE_PENDING) {
     double first_point, last_point;
 
@@ -867,7 +1049,7 @@ handle_scroll_event (AdwSwipeTracker *self,
   }
 
   if (self->state == ADW_SWIPE_TRACKER_STATE_SCROLLING) {
-    if (gdk_scroll_event_is_stop (event)) {
+    if (is_stop) {
       gesture_end (self, distance, time, TRUE);
     } else {
       append_to_history (self, delta, time);
@@ -883,6 +1065,38 @@ handle_scroll_event (AdwSwipeTracker *self,
   return GDK_EVENT_PROPAGATE;
 }
 
+static gboolean
+handle_scroll_event (AdwSwipeTracker *self,
+                     GdkEvent        *event)
+{
+  GdkDevice *source_device;
+  GdkInputSource input_source;
+  double dx, dy;
+  gboolean is_stop;
+  guint32 time;
+
+  if (!event || gdk_event_get_event_type (event) != GDK_SCROLL)
+    return GDK_EVENT_PROPAGATE;
+
+  if (gdk_scroll_event_get_direction (event) != GDK_SCROLL_SMOOTH)
+    return GDK_EVENT_PROPAGATE;
+
+  source_device = gdk_event_get_device (event);
+  input_source = gdk_device_get_source (source_device);
+  if (input_source != GDK_SOURCE_TOUCHPAD)
+    return GDK_EVENT_PROPAGATE;
+
+  gdk_scroll_event_get_deltas (event, &dx, &dy);
+  is_stop = gdk_scroll_event_is_stop (event);
+  time = gdk_event_get_time (event);
+
+  record_event (self,
+                is_stop ? ADW_SWIPE_EVENT_SCROLL_STOP : ADW_SWIPE_EVENT_SCROLL,
+                time, dx, dy);
+
+  return handle_scroll (self, dx, dy, is_stop, time);
+}
+
 static void
 scroll_begin_cb (AdwSwipeTracker          *self,
                  GtkEventControllerScroll *controller)
@@ -1052,17 +1266,9 @@ adw_swipe_tracker_dispose (GObject *object)
 
   set_swipeable (self, NULL);
 
-  G_OBJECT_CLASS (adw_swipe_tracker_parent_class)->dispose (object);
-}
+  g_clear_pointer (&self->snap_points, g_free);
 
-static void
-adw_swipe_tracker_finalize (GObject *object)
-{
-  AdwSwipeTracker *self = ADW_SWIPE_TRACKER (object);
-
-  g_array_free (self->event_history, TRUE);
-
-  G_OBJECT_CLASS (adw_swipe_tracker_parent_class)->finalize (object);
+  G_OBJECT_CLASS (adw_swipe_tracker_parent_class)->dispose (object);
 }
 
 static void
@@ -1172,7 +1378,6 @@ adw_swipe_tracker_class_init (AdwSwipeTrackerClass *klass)
 
   object_class->constructed = adw_swipe_tracker_constructed;
   object_class->dispose = adw_swipe_tracker_dispose;
-  object_class->finalize = adw_swipe_tracker_finalize;
   object_class->get_property = adw_swipe_tracker_get_property;
   object_class->set_property = adw_swipe_tracker_set_property;
 
@@ -1374,7 +1579,6 @@ adw_swipe_tracker_class_init (AdwSwipeTrackerClass *klass)
 static void
 adw_swipe_tracker_init (AdwSwipeTracker *self)
 {
-  self->event_history = g_array_new (FALSE, FALSE, sizeof (EventHistoryRecord));
   reset (self);
 
   self->orientation = GTK_ORIENTATION_HORIZONTAL;
@@ -1725,7 +1929,8 @@ adw_swipe_tracker_set_allow_window_handle (AdwSwipeTracker *self,
  * Moves the current progress value by @delta.
  *
  * This can be used to adjust the current position if snap points move during
- * the gesture.
+ * the gesture. The snap points are requested again afterwards, see
+ * [method@SwipeTracker.invalidate_snap_points].
  */
 void
 adw_swipe_tracker_shift_position (AdwSwipeTracker *self,
@@ -1739,6 +1944,31 @@ adw_swipe_tracker_shift_position (AdwSwipeTracker *self,
 
   self->progress += delta;
   self->initial_progress += delta;
+
+  adw_swipe_tracker_invalidate_snap_points (self);
+}
+
+/**
+ * adw_swipe_tracker_invalidate_snap_points:
+ * @self: a swipe tracker
+ *
+ * Makes @self request the snap points of its swipeable again.
+ *
+ * To avoid requesting them on every event, the snap points are cached until
+ * the end of the gesture. They are refreshed after the
+ * [signal@SwipeTracker::prepare] and [signal@SwipeTracker::begin-swipe]
+ * signals, but swipeable widgets whose snap points can change at any other
+ * point of the gesture, for example because pages are added or removed, must
+ * call this function when that happens.
+ *
+ * Since: 1.5
+ */
+void
+adw_swipe_tracker_invalidate_snap_points (AdwSwipeTracker *self)
+{
+  g_return_if_fail (ADW_IS_SWIPE_TRACKER (self));
+
+  g_clear_pointer (&self->snap_points, g_free);
 }
 
 void
@@ -1756,3 +1986,176 @@ adw_swipe_tracker_reset (AdwSwipeTracker *self)
     gtk_event_controller_reset (self->scroll_controller);
 }
 
+AdwSwipeTracker *
+adw_swipe_tracker_get_for_swipeable (AdwSwipeable *swipeable)
+{
+  g_return_val_if_fail (ADW_IS_SWIPEABLE (swipeable), NULL);
+
+  return g_object_get_data (G_OBJECT (swipeable), "-adw-swipe-tracker");
+}
+
+/*
+ * adw_swipe_tracker_feed_event:
+ * @self: a swipe tracker
+ * @event: the event to feed
+ *
+ * Feeds a synthetic event into @self, bypassing its event controllers.
+ *
+ * Drags behave like a touchscreen drag the swipeable didn't reject in
+ * [signal@Gtk.GestureDrag::drag-begin]: once the sequence would be denied, the
+ * rest of it is ignored until the next `ADW_SWIPE_EVENT_DRAG_BEGIN`. Scroll
+ * events behave like touchpad scrolling at the last known pointer position.
+ *
+ * Only meant for tests and benchmarks, so that recorded gestures can be
+ * replayed deterministically.
+ */
+void
+adw_swipe_tracker_feed_event (AdwSwipeTracker     *self,
+                              const AdwSwipeEvent *event)
+{
+  g_return_if_fail (ADW_IS_SWIPE_TRACKER (self));
+  g_return_if_fail (event != NULL);
+
+  if (!self->enabled || !self->swipeable)
+    return;
+
+  switch (event->type) {
+  case ADW_SWIPE_EVENT_DRAG_BEGIN:
+    self->replay_drag_active = (self->state == ADW_SWIPE_TRACKER_STATE_NONE);
+    self->replay_start_x = event->x;
+    self->replay_start_y = event->y;
+    self->is_window_handle = FALSE;
+    break;
+
+  case ADW_SWIPE_EVENT_DRAG_UPDATE:
+    if (!self->replay_drag_active)
+      break;
+
+    if (handle_drag_update (self,
+                            self->replay_start_x,
+                            self->replay_start_y,
+                            event->x,
+                            event->y,
+                            event->time) == GTK_EVENT_SEQUENCE_DENIED) {
+      /* Denying a sequence ends the gesture right away */
+      self->replay_drag_active = FALSE;
+      handle_drag_end (self, event->time);
+    }
+    break;
+
+  case ADW_SWIPE_EVENT_DRAG_END:
+    if (!self->replay_drag_active)
+      break;
+
+    self->replay_drag_active = FALSE;
+    handle_drag_end (self, event->time);
+    break;
+
+  case ADW_SWIPE_EVENT_DRAG_CANCEL:
+    if (!self->replay_drag_active)
+      break;
+
+    self->replay_drag_active = FALSE;
+    handle_drag_cancel (self, event->time);
+    break;
+
+  case ADW_SWIPE_EVENT_SCROLL:
+  case ADW_SWIPE_EVENT_SCROLL_STOP:
+    handle_scroll (self,
+                   event->x,
+                   event->y,
+                   event->type == ADW_SWIPE_EVENT_SCROLL_STOP,
+                   event->time);
+    break;
+
+  default:
+    g_assert_not_reached ();
+  }
+}
+
+/*
+ * adw_swipe_events_parse:
+ * @contents: the recording
+ * @error: return location for an error
+ *
+ * Parses a recording made with the `ADW_SWIPE_RECORD` environment variable.
+ *
+ * Each line is an event name, a timestamp in milliseconds and two
+ * coordinates: the start point for `drag-begin`, the offset from it for other
+ * drag events and the deltas for scroll events. Empty lines and lines starting
+ * with `#` are skipped.
+ *
+ * Returns: (transfer full): an array of `AdwSwipeEvent`
+ */
+GArray *
+adw_swipe_events_parse (const char  *contents,
+                        GError     **error)
+{
+  g_autoptr (GArray) events = NULL;
+  g_auto (GStrv) lines = NULL;
+  int i;
+
+  g_return_val_if_fail (contents != NULL, NULL);
+  g_return_val_if_fail (error == NULL || *error == NULL, NULL);
+
+  events = g_array_new (FALSE, FALSE, sizeof (AdwSwipeEvent));
+  lines = g_strsplit (contents, "\n", -1);
+
+  for (i = 0; lines[i]; i++) {
+    g_auto (GStrv) fields = NULL;
+    AdwSwipeEvent event;
+    char *line = g_strstrip (lines[i]);
+    char *end;
+    guint64 time;
+    gsize type;
+
+    if (!*line || *line == '#')
+      continue;
+
+    fields = g_strsplit_set (line, " \t", -1);
+
+    if (g_strv_length (fields) != 4) {
+      g_set_error (error, G_IO_ERROR, G_IO_ERROR_INVALID_DATA,
+                   "Line %d: Expected 4 fields", i + 1);
+      return NULL;
+    }
+
+    for (type = 0; type < G_N_ELEMENTS (event_names); type++)
+      if (!g_strcmp0 (fields[0], event_names[type]))
+        break;
+
+    if (type == G_N_ELEMENTS (event_names)) {
+      g_set_error (error, G_IO_ERROR, G_IO_ERROR_INVALID_DATA,
+                   "Line %d: Unknown event “%s”", i + 1, fields[0]);
+      return NULL;
+    }
+
+    time = g_ascii_strtoull (fields[1], &end, 10);
+    if (*end || end == fields[1] || time > G_MAXUINT32) {
+      g_set_error (error, G_IO_ERROR, G_IO_ERROR_INVALID_DATA,
+                   "Line %d: Invalid timestamp “%s”", i + 1, fields[1]);
+      return NULL;
+    }
+
+    event.type = type;
+    event.time = (guint32) time;
+
+    event.x = g_ascii_strtod (fields[2], &end);
+    if (*end || end == fields[2]) {
+      g_set_error (error, G_IO_ERROR, G_IO_ERROR_INVALID_DATA,
+                   "Line %d: Invalid coordinate “%s”", i + 1, fields[2]);
+      return NULL;
+    }
+
+    event.y = g_ascii_strtod (fields[3], &end);
+    if (*end || end == fields[3]) {
+      g_set_error (error, G_IO_ERROR, G_IO_ERROR_INVALID_DATA,
+                   "Line %d: Invalid coordinate “%s”", i + 1, fields[3]);
+      return NULL;
+    }
+
+    g_array_append_val (events, event);
+  }
+
+  return g_steal_pointer (&events);
+}
@@ -74,4 +74,7 @@ ADW_AVAILABLE_IN_ALL
 void adw_swipe_tracker_shift_position (AdwSwipeTracker *self,
                                        double           delta);
 
+ADW_AVAILABLE_IN_1_5
+void adw_swipe_tracker_invalidate_snap_points (AdwSwipeTracker *self);
+
 G_END_DECLS
@@ -15,6 +15,7 @@
 #include "adw-view-stack.h"
 
 #include "adw-animation-util.h"
+#include "adw-bin.h"
 #include "adw-gizmo-private.h"
 #include "adw-widget-utils-private.h"
 
@@ -118,6 +119,12 @@ struct _AdwViewStackPage {
   GtkATContext *at_context;
   AdwViewStackPage *next_page;
 
+  AdwViewStackPageFunc child_func;
+  gpointer child_func_data;
+  GDestroyNotify child_func_data_destroy;
+  int release_delay;
+  guint release_id;
+
   gboolean needs_attention;
   gboolean visible;
   gboolean use_underline;
@@ -139,6 +146,7 @@ enum {
   PAGE_PROP_NEEDS_ATTENTION,
   PAGE_PROP_BADGE_NUMBER,
   PAGE_PROP_VISIBLE,
+  PAGE_PROP_RELEASE_DELAY,
   LAST_PAGE_PROP,
   PAGE_PROP_ACCESSIBLE_ROLE
 };
@@ -163,6 +171,12 @@ struct _AdwViewStack {
   GtkWidget parent_instance;
 
   GList *children;
+  GList *last_child;
+  guint n_children;
+
+  GHashTable *links_by_widget;
+  GHashTable *pages_by_name;
+  guint n_shadowed_names;
 
   AdwViewStackPage *visible_child;
 
@@ -215,6 +229,9 @@ adw_view_stack_page_get_property (GObject      *object,
   case PAGE_PROP_VISIBLE:
     g_value_set_boolean (value, adw_view_stack_page_get_visible (self));
     break;
+  case PAGE_PROP_RELEASE_DELAY:
+    g_value_set_int (value, adw_view_stack_page_get_release_delay (self));
+    break;
   case PAGE_PROP_ACCESSIBLE_ROLE:
     g_value_set_enum (value, GTK_ACCESSIBLE_ROLE_TAB_PANEL);
     break;
@@ -257,6 +274,9 @@ adw_view_stack_page_set_property (GObject      *object,
   case PAGE_PROP_VISIBLE:
     adw_view_stack_page_set_visible (self, g_value_get_boolean (value));
     break;
+  case PAGE_PROP_RELEASE_DELAY:
+    adw_view_stack_page_set_release_delay (self, g_value_get_int (value));
+    break;
   case PAGE_PROP_ACCESSIBLE_ROLE:
     break;
   default:
@@ -273,6 +293,11 @@ adw_view_stack_page_dispose (GObject *object)
   self->in_destruction = TRUE;
 
   g_clear_object (&self->at_context);
+  g_clear_handle_id (&self->release_id, g_source_remove);
+
+  if (self->child_func_data_destroy)
+    g_clear_pointer (&self->child_func_data, self->child_func_data_destroy);
+  self->child_func = NULL;
 
   G_OBJECT_CLASS (adw_view_stack_page_parent_class)->dispose (object);
 }
@@ -394,6 +419,24 @@ adw_view_stack_page_class_init (AdwViewStackPageClass *class)
                           TRUE,
                           G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS | G_PARAM_EXPLICIT_NOTIFY);
 
+  /**
+   * AdwViewStackPage:release-delay: (attributes org.gtk.Property.get=adw_view_stack_page_get_release_delay org.gtk.Property.set=adw_view_stack_page_set_release_delay)
+   *
+   * How long the page keeps its content after being hidden, in milliseconds.
+   *
+   * Only pages added with [method@ViewStack.add_lazy] can release their
+   * content. Once the delay passes, the content is destroyed, and it's created
+   * again the next time the page becomes visible.
+   *
+   * If set to -1, the content is kept.
+   *
+   * Since: 1.5
+   */
+  page_props[PAGE_PROP_RELEASE_DELAY] =
+    g_param_spec_int ("release-delay", NULL, NULL,
+                      -1, G_MAXINT, -1,
+                      G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS | G_PARAM_EXPLICIT_NOTIFY);
+
   g_object_class_install_properties (object_class, LAST_PAGE_PROP, page_props);
 
   g_object_class_override_property (object_class, PAGE_PROP_ACCESSIBLE_ROLE, "accessible-role");
@@ -403,6 +446,7 @@ static void
 adw_view_stack_page_init (AdwViewStackPage *self)
 {
   self->visible = TRUE;
+  self->release_delay = -1;
 }
 
 static GtkATContext *
@@ -511,7 +555,7 @@ adw_view_stack_pages_get_n_items (GListModel *model)
 {
   AdwViewStackPages *self = ADW_VIEW_STACK_PAGES (model);
 
-  return g_list_length (self->stack->children);
+  return self->stack->n_children;
 }
 
 static gpointer
@@ -719,17 +763,7 @@ static GList *
 find_link_for_widget (AdwViewStack *self,
                       GtkWidget    *child)
 {
-  AdwViewStackPage *page;
-  GList *l;
-
-  for (l = self->children; l; l = l->next) {
-    page = l->data;
-
-    if (page->widget == child)
-      return l;
-  }
-
-  return NULL;
+  return g_hash_table_lookup (self->links_by_widget, child);
 }
 
 static AdwViewStackPage *
@@ -748,17 +782,132 @@ static AdwViewStackPage *
 find_page_for_name (AdwViewStack *self,
                     const char   *name)
 {
-  AdwViewStackPage *page;
+  if (!name)
+    return NULL;
+
+  return g_hash_table_lookup (self->pages_by_name, name);
+}
+
+static gboolean
+page_precedes (AdwViewStack     *self,
+               AdwViewStackPage *page,
+               AdwViewStackPage *other)
+{
   GList *l;
 
   for (l = self->children; l; l = l->next) {
-    page = l->data;
+    if (l->data == page)
+      return TRUE;
 
-    if (g_strcmp0 (page->name, name) == 0)
-      return page;
+    if (l->data == other)
+      return FALSE;
   }
 
-  return NULL;
+  return FALSE;
+}
+
+static void
+index_page_name (AdwViewStack     *self,
+                 AdwViewStackPage *page)
+{
+  AdwViewStackPage *existing;
+
+  if (!page->name)
+    return;
+
+  /* With duplicate names, the first page wins. Remember that there are
+   * shadowed pages so that unindexing knows when to look for them. A renamed
+   * page can come before the one currently holding its new name, so it may
+   * have to take over. */
+  existing = g_hash_table_lookup (self->pages_by_name, page->name);
+  if (existing) {
+    self->n_shadowed_names++;
+
+    if (!page_precedes (self, page, existing))
+      return;
+  }
+
+  /* Replace the key as well, it belongs to the page */
+  g_hash_table_replace (self->pages_by_name, page->name, page);
+}
+
+static void
+unindex_page_name (AdwViewStack     *self,
+                   AdwViewStackPage *page)
+{
+  GList *l;
+
+  if (!page->name)
+    return;
+
+  if (g_hash_table_lookup (self->pages_by_name, page->name) != page) {
+    self->n_shadowed_names--;
+    return;
+  }
+
+  g_hash_table_remove (self->pages_by_name, page->name);
+
+  if (self->n_shadowed_names == 0)
+    return;
+
+  for (l = self->children; l; l = l->next) {
+    AdwViewStackPage *p = l->data;
+
+    if (p != page && g_strcmp0 (p->name, page->name) == 0) {
+      g_hash_table_insert (self->pages_by_name, p->name, p);
+      self->n_shadowed_names--;
+      break;
+    }
+  }
+}
+
+static void
+load_page (AdwViewStackPage *page)
+{
+  GtkWidget *child;
+
+  g_clear_handle_id (&page->release_id, g_source_remove);
+
+  if (!page->child_func || adw_bin_get_child (ADW_BIN (page->widget)))
+    return;
+
+  child = page->child_func (page, page->child_func_data);
+
+  g_return_if_fail (GTK_IS_WIDGET (child));
+
+  g_object_ref_sink (child);
+  adw_bin_set_child (ADW_BIN (page->widget), child);
+  g_object_unref (child);
+}
+
+static void
+release_page (AdwViewStackPage *page)
+{
+  page->release_id = 0;
+
+  if (!page->widget)
+    return;
+
+  if (page->last_focus) {
+    g_object_remove_weak_pointer (G_OBJECT (page->last_focus),
+                                  (gpointer *) &page->last_focus);
+    page->last_focus = NULL;
+  }
+
+  adw_bin_set_child (ADW_BIN (page->widget), NULL);
+}
+
+static void
+schedule_release (AdwViewStackPage *page)
+{
+  if (!page->child_func || page->release_delay < 0)
+    return;
+
+  g_clear_handle_id (&page->release_id, g_source_remove);
+
+  page->release_id = g_timeout_add_once (page->release_delay,
+                                         (GSourceOnceFunc) release_page,
+                                         page);
 }
 
 static void
@@ -829,12 +978,17 @@ set_visible_child (AdwViewStack     *self,
                                (gpointer *)&self->visible_child->last_focus);
   }
 
-  if (self->visible_child && self->visible_child->widget)
+  if (self->visible_child && self->visible_child->widget) {
     gtk_widget_set_child_visible (self->visible_child->widget, FALSE);
 
+    schedule_release (self->visible_child);
+  }
+
   self->visible_child = page;
 
   if (page) {
+    load_page (page);
+
     gtk_widget_set_child_visible (page->widget, TRUE);
 
     if (contains_focus) {
@@ -903,42 +1057,47 @@ stack_child_visibility_notify_cb (GObject    *obj,
 }
 
 static void
-add_page (AdwViewStack     *self,
-          AdwViewStackPage *page)
+append_page (AdwViewStack     *self,
+             AdwViewStackPage *page)
 {
-  GList *l;
+  if (find_page_for_name (self, page->name))
+    g_warning ("While adding page: duplicate child name in AdwViewStack: %s", page->name);
 
-  g_return_if_fail (page->widget != NULL);
-
-  if (page->name) {
-    for (l = self->children; l; l = l->next) {
-      AdwViewStackPage *p = l->data;
-
-      if (p->name && g_strcmp0 (p->name, page->name) == 0) {
-        g_warning ("While adding page: duplicate child name in AdwViewStack: %s", page->name);
-        break;
-      }
-    }
-  }
-
-  if (self->children) {
-    AdwViewStackPage *prev_last = g_list_last (self->children)->data;
+  /* Append to the last link so that we don't walk the whole list */
+  if (self->last_child) {
+    AdwViewStackPage *prev_last = self->last_child->data;
 
     prev_last->next_page = page;
+
+    self->last_child = g_list_append (self->last_child, g_object_ref (page))->next;
   } else {
     page->next_page = NULL;
+
+    self->children = self->last_child = g_list_append (NULL, g_object_ref (page));
   }
 
-  self->children = g_list_append (self->children, g_object_ref (page));
+  self->n_children++;
+
+  g_hash_table_insert (self->links_by_widget, page->widget, self->last_child);
+  index_page_name (self, page);
 
   gtk_widget_set_child_visible (page->widget, FALSE);
   gtk_widget_set_parent (page->widget, GTK_WIDGET (self));
 
-  if (self->pages)
-    g_list_model_items_changed (G_LIST_MODEL (self->pages), g_list_length (self->children) - 1, 0, 1);
-
   g_signal_connect (page->widget, "notify::visible",
                     G_CALLBACK (stack_child_visibility_notify_cb), self);
+}
+
+static void
+add_page (AdwViewStack     *self,
+          AdwViewStackPage *page)
+{
+  g_return_if_fail (page->widget != NULL);
+
+  append_page (self, page);
+
+  if (self->pages)
+    g_list_model_items_changed (G_LIST_MODEL (self->pages), self->n_children - 1, 0, 1);
 
   if (self->visible_child == NULL &&
       gtk_widget_get_visible (page->widget))
@@ -993,25 +1152,32 @@ stack_remove (AdwViewStack  *self,
                                         stack_child_visibility_notify_cb,
                                         self);
 
+  g_clear_handle_id (&page->release_id, g_source_remove);
+
   was_visible = gtk_widget_get_visible (child);
 
   if (self->visible_child == page)
     self->visible_child = NULL;
 
+  g_hash_table_remove (self->links_by_widget, child);
+  unindex_page_name (self, page);
+
   gtk_widget_unparent (child);
 
   g_clear_object (&page->widget);
 
-  l = l->prev;
+  if (self->last_child == l)
+    self->last_child = l->prev;
 
-  self->children = g_list_remove (self->children, page);
-
-  if (l) {
-    AdwViewStackPage *prev_page = l->data;
+  if (l->prev) {
+    AdwViewStackPage *prev_page = l->prev->data;
 
     prev_page->next_page = page->next_page;
   }
 
+  self->children = g_list_delete_link (self->children, l);
+  self->n_children--;
+
   g_object_unref (page);
 
   if (!in_dispose &&
@@ -1139,7 +1305,7 @@ adw_view_stack_dispose (GObject *object)
 
   if (self->pages)
     g_list_model_items_changed (G_LIST_MODEL (self->pages), 0,
-                                g_list_length (self->children), 0);
+                                self->n_children, 0);
 
   while ((child = gtk_widget_get_first_child (GTK_WIDGET (self))))
     stack_remove (self, child, TRUE);
@@ -1156,6 +1322,9 @@ adw_view_stack_finalize (GObject *object)
     g_object_remove_weak_pointer (G_OBJECT (self->pages),
                                   (gpointer *) &self->pages);
 
+  g_hash_table_unref (self->links_by_widget);
+  g_hash_table_unref (self->pages_by_name);
+
   G_OBJECT_CLASS (adw_view_stack_parent_class)->finalize (object);
 }
 
@@ -1254,6 +1423,9 @@ adw_view_stack_init (AdwViewStack *self)
 {
   self->homogeneous[GTK_ORIENTATION_VERTICAL] = TRUE;
   self->homogeneous[GTK_ORIENTATION_HORIZONTAL] = TRUE;
+
+  self->links_by_widget = g_hash_table_new (NULL, NULL);
+  self->pages_by_name = g_hash_table_new (g_str_hash, g_str_equal);
 }
 
 static void
@@ -1303,6 +1475,9 @@ adw_view_stack_accessible_init (GtkAccessibleInterface *iface)
  *
  * Gets the stack child to which @self belongs.
  *
+ * For pages added with [method@ViewStack.add_lazy], this is an [class@Bin]
+ * holding the content once it has been created.
+ *
  * Returns: (transfer none): the child to which @self belongs
  */
 GtkWidget *
@@ -1344,28 +1519,27 @@ adw_view_stack_page_set_name (AdwViewStackPage *self,
 
   g_return_if_fail (ADW_IS_VIEW_STACK_PAGE (self));
 
+  if (!g_strcmp0 (self->name, name))
+    return;
+
   if (self->widget &&
       gtk_widget_get_parent (self->widget) &&
-      ADW_IS_VIEW_STACK (gtk_widget_get_parent (self->widget)) &&
-      name) {
-    GList *l;
+      ADW_IS_VIEW_STACK (gtk_widget_get_parent (self->widget))) {
+    AdwViewStackPage *existing;
 
     stack = ADW_VIEW_STACK (gtk_widget_get_parent (self->widget));
 
-    for (l = stack->children; l; l = l->next) {
-      AdwViewStackPage *p = l->data;
-      if (self == p)
-        continue;
+    existing = find_page_for_name (stack, name);
+    if (existing && existing != self)
+      g_warning ("Duplicate child name in AdwViewStack: %s", name);
 
-      if (g_strcmp0 (p->name, name) == 0) {
-        g_warning ("Duplicate child name in AdwViewStack: %s", name);
-        break;
-      }
-    }
+    unindex_page_name (stack, self);
   }
 
-  if (!g_set_str (&self->name, name))
-    return;
+  g_set_str (&self->name, name);
+
+  if (stack)
+    index_page_name (stack, self);
 
   g_object_notify_by_pspec (G_OBJECT (self), page_props[PAGE_PROP_NAME]);
 
@@ -1614,6 +1788,54 @@ adw_view_stack_page_set_visible (AdwViewStackPage *self,
   g_object_notify_by_pspec (G_OBJECT (self), page_props[PAGE_PROP_VISIBLE]);
 }
 
+/**
+ * adw_view_stack_page_get_release_delay: (attributes org.gtk.Method.get_property=release-delay)
+ * @self: a view stack page
+ *
+ * Gets how long @self keeps its content after being hidden.
+ *
+ * Returns: the delay in milliseconds, or -1 if the content is kept
+ *
+ * Since: 1.5
+ */
+int
+adw_view_stack_page_get_release_delay (AdwViewStackPage *self)
+{
+  g_return_val_if_fail (ADW_IS_VIEW_STACK_PAGE (self), -1);
+
+  return self->release_delay;
+}
+
+/**
+ * adw_view_stack_page_set_release_delay: (attributes org.gtk.Method.set_property=release-delay)
+ * @self: a view stack page
+ * @release_delay: the delay in milliseconds, or -1 to keep the content
+ *
+ * Sets how long @self keeps its content after being hidden.
+ *
+ * Only pages added with [method@ViewStack.add_lazy] can release their
+ * content.
+ *
+ * Since: 1.5
+ */
+void
+adw_view_stack_page_set_release_delay (AdwViewStackPage *self,
+                                       int               release_delay)
+{
+  g_return_if_fail (ADW_IS_VIEW_STACK_PAGE (self));
+  g_return_if_fail (release_delay >= -1);
+
+  if (release_delay == self->release_delay)
+    return;
+
+  self->release_delay = release_delay;
+
+  if (release_delay < 0)
+    g_clear_handle_id (&self->release_id, g_source_remove);
+
+  g_object_notify_by_pspec (G_OBJECT (self), page_props[PAGE_PROP_RELEASE_DELAY]);
+}
+
 /**
  * adw_view_stack_new:
  *
@@ -1729,6 +1951,121 @@ adw_view_stack_add_titled_with_icon (AdwViewStack *self,
   return add_internal (self, child, name, title, icon_name);
 }
 
+/**
+ * adw_view_stack_add_lazy:
+ * @self: a view stack
+ * @name: (nullable): the name for the page
+ * @title: (nullable): a human-readable title for the page
+ * @icon_name: (nullable): an icon name for the page
+ * @child_func: (scope notified) (closure user_data) (destroy user_data_destroy): a function that creates the content of the page
+ * @user_data: user data for @child_func
+ * @user_data_destroy: destroy notifier for @user_data
+ *
+ * Adds a page to @self without creating its content.
+ *
+ * The page is identified by the @name, and [class@ViewSwitcher] uses @title
+ * and @icon_name to represent it, same as with
+ * [method@ViewStack.add_titled_with_icon].
+ *
+ * @child_func is called to create the content the first time the page becomes
+ * visible. Set [property@ViewStackPage:release-delay] to destroy the content
+ * again after the page has been hidden for a while.
+ *
+ * Until the content is created, the page doesn't contribute to the size of
+ * @self, even if it's homogeneous.
+ *
+ * Returns: (transfer none): the `AdwViewStackPage` for the new page
+ *
+ * Since: 1.5
+ */
+AdwViewStackPage *
+adw_view_stack_add_lazy (AdwViewStack         *self,
+                         const char           *name,
+                         const char           *title,
+                         const char           *icon_name,
+                         AdwViewStackPageFunc  child_func,
+                         gpointer              user_data,
+                         GDestroyNotify        user_data_destroy)
+{
+  AdwViewStackPage *page;
+
+  g_return_val_if_fail (ADW_IS_VIEW_STACK (self), NULL);
+  g_return_val_if_fail (child_func != NULL, NULL);
+
+  page = g_object_new (ADW_TYPE_VIEW_STACK_PAGE, NULL);
+  page->widget = g_object_ref (adw_bin_new ());
+  page->name = g_strdup (name);
+  page->title = g_strdup (title);
+  page->icon_name = g_strdup (icon_name);
+  page->child_func = child_func;
+  page->child_func_data = user_data;
+  page->child_func_data_destroy = user_data_destroy;
+
+  add_page (self, page);
+
+  g_object_unref (page);
+
+  return page;
+}
+
+/**
+ * adw_view_stack_add_pages:
+ * @self: a view stack
+ * @pages: (array length=n_pages): the pages to add
+ * @n_pages: the number of elements in @pages
+ *
+ * Adds multiple pages to @self at once.
+ *
+ * The pages must have [property@ViewStackPage:child] set, and their children
+ * must not have a parent yet. They can be created with
+ * `g_object_new (ADW_TYPE_VIEW_STACK_PAGE, "child", child, ...)`.
+ *
+ * Unlike calling [method@ViewStack.add] for each child, this only emits
+ * [signal@Gio.ListModel::items-changed] on [property@ViewStack:pages] once,
+ * which is considerably faster when populating a stack with many pages.
+ *
+ * Since: 1.5
+ */
+void
+adw_view_stack_add_pages (AdwViewStack      *self,
+                          AdwViewStackPage **pages,
+                          int                n_pages)
+{
+  AdwViewStackPage *first_visible = NULL;
+  guint position;
+  int i;
+
+  g_return_if_fail (ADW_IS_VIEW_STACK (self));
+  g_return_if_fail (pages != NULL || n_pages == 0);
+  g_return_if_fail (n_pages >= 0);
+
+  for (i = 0; i < n_pages; i++) {
+    g_return_if_fail (ADW_IS_VIEW_STACK_PAGE (pages[i]));
+    g_return_if_fail (GTK_IS_WIDGET (pages[i]->widget));
+    g_return_if_fail (gtk_widget_get_parent (pages[i]->widget) == NULL);
+  }
+
+  if (n_pages == 0)
+    return;
+
+  position = self->n_children;
+
+  for (i = 0; i < n_pages; i++) {
+    append_page (self, pages[i]);
+
+    if (!first_visible && gtk_widget_get_visible (pages[i]->widget))
+      first_visible = pages[i];
+  }
+
+  if (self->pages)
+    g_list_model_items_changed (G_LIST_MODEL (self->pages), position, 0, n_pages);
+
+  if (self->visible_child == NULL && first_visible)
+    set_visible_child (self, first_visible);
+
+  gtk_widget_queue_resize (GTK_WIDGET (self));
+}
+
 /**
  * adw_view_stack_remove:
  * @self: a view stack
@@ -1740,19 +2077,13 @@ void
 adw_view_stack_remove (AdwViewStack  *self,
                        GtkWidget     *child)
 {
-  GList *l;
   guint position;
 
   g_return_if_fail (ADW_IS_VIEW_STACK (self));
   g_return_if_fail (GTK_IS_WIDGET (child));
   g_return_if_fail (gtk_widget_get_parent (child) == GTK_WIDGET (self));
 
-  for (l = self->children, position = 0; l; l = l->next, position++) {
-    AdwViewStackPage *page = l->data;
-
-    if (page->widget == child)
-      break;
-  }
+  position = g_list_position (self->children, find_link_for_widget (self, child));
 
   stack_remove (self, child, FALSE);
 
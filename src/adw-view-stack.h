@@ -72,6 +72,26 @@ ADW_AVAILABLE_IN_ALL
 void     adw_view_stack_page_set_visible (AdwViewStackPage *self,
                                           gboolean          visible);
 
+ADW_AVAILABLE_IN_1_5
+int  adw_view_stack_page_get_release_delay (AdwViewStackPage *self);
+ADW_AVAILABLE_IN_1_5
+void adw_view_stack_page_set_release_delay (AdwViewStackPage *self,
+                                            int               release_delay);
+
+/**
+ * AdwViewStackPageFunc:
+ * @page: the page that needs content
+ * @user_data: (closure): user data
+ *
+ * Called to create the content of @page when it's about to be shown.
+ *
+ * Returns: (transfer none): the new content
+ *
+ * Since: 1.5
+ */
+typedef GtkWidget *(*AdwViewStackPageFunc) (AdwViewStackPage *page,
+                                            gpointer          user_data);
+
 #define ADW_TYPE_VIEW_STACK (adw_view_stack_get_type())
 
 ADW_AVAILABLE_IN_ALL
@@ -99,6 +119,20 @@ AdwViewStackPage *adw_view_stack_add_titled_with_icon (AdwViewStack *self,
                                                        const char   *title,
                                                        const char   *icon_name);
 
+ADW_AVAILABLE_IN_1_5
+AdwViewStackPage *adw_view_stack_add_lazy (AdwViewStack         *self,
+                                           const char           *name,
+                                           const char           *title,
+                                           const char           *icon_name,
+                                           AdwViewStackPageFunc  child_func,
+                                           gpointer              user_data,
+                                           GDestroyNotify        user_data_destroy);
+
+ADW_AVAILABLE_IN_1_5
+void adw_view_stack_add_pages (AdwViewStack      *self,
+                               AdwViewStackPage **pages,
+                               int                n_pages);
+
 ADW_AVAILABLE_IN_ALL
 void adw_view_stack_remove (AdwViewStack *self,
                             GtkWidget    *child);
@@ -111,6 +111,7 @@ struct _AdwViewSwitcher
   AdwViewStack *stack;
   GtkSelectionModel *pages;
   GHashTable *buttons;
+  GPtrArray *button_list;
 
   AdwViewSwitcherPolicy policy;
 };
@@ -124,20 +125,32 @@ on_button_toggled (GtkWidget       *button,
                    GParamSpec      *pspec,
                    AdwViewSwitcher *self)
 {
+  AdwViewStackPages *pages = ADW_VIEW_STACK_PAGES (self->pages);
+  AdwViewStackPage *page;
   gboolean active;
-  guint index;
 
   active = gtk_toggle_button_get_active (GTK_TOGGLE_BUTTON (button));
-  index = GPOINTER_TO_UINT (g_object_get_data (G_OBJECT (button), "child-index"));
+  page = g_object_get_data (G_OBJECT (button), "page");
 
   if (active) {
-      gtk_selection_model_select_item (self->pages, index, TRUE);
+    adw_view_stack_pages_set_selected_page (pages, page);
   } else {
-    gboolean selected = gtk_selection_model_is_selected (self->pages, index);
+    gboolean selected = adw_view_stack_pages_get_selected_page (pages) == page;
     gtk_toggle_button_set_active (GTK_TOGGLE_BUTTON (button), selected);
   }
 }
 
+static void
+update_button_visible (AdwViewStackPage *page,
+                       GtkWidget        *button)
+{
+  gboolean visible = adw_view_stack_page_get_visible (page) &&
+                     (adw_view_stack_page_get_title (page) != NULL ||
+                      adw_view_stack_page_get_icon_name (page) != NULL);
+
+  gtk_widget_set_visible (button, visible);
+}
+
 static void
 update_button (AdwViewSwitcher  *self,
                AdwViewStackPage *page,
@@ -147,14 +160,12 @@ update_button (AdwViewSwitcher  *self,
   char *icon_name;
   gboolean needs_attention;
   guint badge_number;
-  gboolean visible;
   gboolean use_underline;
 
   g_object_get (page,
                 "title", &title,
                 "icon-name", &icon_name,
                 "needs-attention", &needs_attention,
-                "visible", &visible,
                 "badge-number", &badge_number,
                 "use-underline", &use_underline,
                 NULL);
@@ -167,7 +178,7 @@ update_button (AdwViewSwitcher  *self,
                 "use-underline", use_underline,
                 NULL);
 
-  gtk_widget_set_visible (button, visible && (title != NULL || icon_name != NULL));
+  update_button_visible (page, button);
 
   g_free (title);
   g_free (icon_name);
@@ -178,10 +189,28 @@ on_page_updated (AdwViewStackPage *page,
                  GParamSpec       *pspec,
                  AdwViewSwitcher  *self)
 {
-  GtkWidget *button;
+  AdwViewSwitcherButton *button;
+  const char *name;
 
   button = g_hash_table_lookup (self->buttons, page);
-  update_button (self, page, button);
+  name = g_param_spec_get_name (pspec);
+
+  /* Only update what changed, the name and the child don't affect the button */
+  if (!g_strcmp0 (name, "title")) {
+    adw_view_switcher_button_set_label (button, adw_view_stack_page_get_title (page));
+    update_button_visible (page, GTK_WIDGET (button));
+  } else if (!g_strcmp0 (name, "icon-name")) {
+    adw_view_switcher_button_set_icon_name (button, adw_view_stack_page_get_icon_name (page));
+    update_button_visible (page, GTK_WIDGET (button));
+  } else if (!g_strcmp0 (name, "visible")) {
+    update_button_visible (page, GTK_WIDGET (button));
+  } else if (!g_strcmp0 (name, "needs-attention")) {
+    adw_view_switcher_button_set_needs_attention (button, adw_view_stack_page_get_needs_attention (page));
+  } else if (!g_strcmp0 (name, "badge-number")) {
+    adw_view_switcher_button_set_badge_number (button, adw_view_stack_page_get_badge_number (page));
+  } else if (!g_strcmp0 (name, "use-underline")) {
+    gtk_button_set_use_underline (GTK_BUTTON (button), adw_view_stack_page_get_use_underline (page));
+  }
 }
 
 static void
@@ -190,14 +219,18 @@ add_child (AdwViewSwitcher *self,
 {
   AdwViewSwitcherButton *button = ADW_VIEW_SWITCHER_BUTTON (adw_view_switcher_button_new ());
   AdwViewStackPage *page;
+  GtkWidget *prev_sibling = NULL;
   gboolean selected;
 
   page = g_list_model_get_item (G_LIST_MODEL (self->pages), position);
   update_button (self, page, GTK_WIDGET (button));
 
-  gtk_widget_set_parent (GTK_WIDGET (button), GTK_WIDGET (self));
+  if (position > 0)
+    prev_sibling = g_ptr_array_index (self->button_list, position - 1);
 
-  g_object_set_data (G_OBJECT (button), "child-index", GUINT_TO_POINTER (position));
+  gtk_widget_insert_after (GTK_WIDGET (button), GTK_WIDGET (self), prev_sibling);
+
+  g_object_set_data (G_OBJECT (button), "page", page);
   selected = gtk_selection_model_is_selected (self->pages, position);
   gtk_toggle_button_set_active (GTK_TOGGLE_BUTTON (button), selected);
 
@@ -211,11 +244,28 @@ add_child (AdwViewSwitcher *self,
   g_signal_connect (button, "notify::active", G_CALLBACK (on_button_toggled), self);
   g_signal_connect (page, "notify", G_CALLBACK (on_page_updated), self);
 
+  g_ptr_array_insert (self->button_list, position, button);
   g_hash_table_insert (self->buttons, g_object_ref (page), button);
 
   g_object_unref (page);
 }
 
+static void
+remove_child (AdwViewSwitcher *self,
+              guint            position)
+{
+  GtkWidget *button = g_ptr_array_index (self->button_list, position);
+  AdwViewStackPage *page = g_object_get_data (G_OBJECT (button), "page");
+
+  g_signal_handlers_disconnect_by_func (page, on_page_updated, self);
+
+  g_ptr_array_remove_index (self->button_list, position);
+  gtk_widget_unparent (button);
+
+  /* The table holds the reference to the page, so remove it last */
+  g_hash_table_remove (self->buttons, page);
+}
+
 static void
 populate_switcher (AdwViewSwitcher *self)
 {
@@ -229,24 +279,23 @@ populate_switcher (AdwViewSwitcher *self)
 static void
 clear_switcher (AdwViewSwitcher *self)
 {
-  GHashTableIter iter;
-  GtkWidget *page;
-  GtkWidget *button;
-
-  g_hash_table_iter_init (&iter, self->buttons);
-  while (g_hash_table_iter_next (&iter, (gpointer *) &page, (gpointer *) &button)) {
-    gtk_widget_unparent (button);
-    g_signal_handlers_disconnect_by_func (page, on_page_updated, self);
-    g_hash_table_iter_remove (&iter);
-  }
+  while (self->button_list->len > 0)
+    remove_child (self, self->button_list->len - 1);
 }
 
-
 static void
-items_changed_cb (AdwViewSwitcher *self)
+items_changed_cb (AdwViewSwitcher *self,
+                  guint            position,
+                  guint            removed,
+                  guint            added)
 {
-  clear_switcher (self);
-  populate_switcher (self);
+  guint i;
+
+  for (i = 0; i < removed; i++)
+    remove_child (self, position);
+
+  for (i = 0; i < added; i++)
+    add_child (self, position + i);
 }
 
 static void
@@ -254,26 +303,21 @@ selection_changed_cb (AdwViewSwitcher   *self,
                       guint              position,
                       guint              n_items)
 {
+  AdwViewStackPage *selected_page;
   guint i;
 
-  for (i = position; i < position + n_items; i++) {
-    AdwViewStackPage *page = NULL;
-    GtkWidget *button;
-    gboolean selected;
+  selected_page = adw_view_stack_pages_get_selected_page (ADW_VIEW_STACK_PAGES (self->pages));
 
-    page = g_list_model_get_item (G_LIST_MODEL (self->pages), i);
-    button = g_hash_table_lookup (self->buttons, page);
-
-    if (button) {
-      selected = gtk_selection_model_is_selected (self->pages, i);
-      gtk_toggle_button_set_active (GTK_TOGGLE_BUTTON (button), selected);
+  for (i = position; i < position + n_items && i < self->button_list->len; i++) {
+    GtkWidget *button = g_ptr_array_index (self->button_list, i);
+    gboolean selected;
 
-      gtk_accessible_update_state (GTK_ACCESSIBLE (button),
-                                   GTK_ACCESSIBLE_STATE_SELECTED, selected,
-                                   -1);
-    }
+    selected = g_object_get_data (G_OBJECT (button), "page") == selected_page;
+    gtk_toggle_button_set_active (GTK_TOGGLE_BUTTON (button), selected);
 
-    g_object_unref (page);
+    gtk_accessible_update_state (GTK_ACCESSIBLE (button),
+                                 GTK_ACCESSIBLE_STATE_SELECTED, selected,
+                                 -1);
   }
 }
 
@@ -374,6 +418,7 @@ adw_view_switcher_finalize (GObject *object)
   AdwViewSwitcher *self = ADW_VIEW_SWITCHER (object);
 
   g_hash_table_destroy (self->buttons);
+  g_ptr_array_unref (self->button_list);
 
   G_OBJECT_CLASS (adw_view_switcher_parent_class)->finalize (object);
 }
@@ -427,6 +472,7 @@ adw_view_switcher_init (AdwViewSwitcher *self)
   gtk_widget_add_css_class (GTK_WIDGET (self), "narrow");
 
   self->buttons = g_hash_table_new_full (g_direct_hash, g_direct_equal, g_object_unref, NULL);
+  self->button_list = g_ptr_array_new ();
 }
 
 /**
@@ -1,24 +1,79 @@
 #!/usr/bin/env python3
 
+import argparse
 import os
 import re
-import sys
 
-def main(argv):
+# Mirrors type_name_mangle() in gtk/gtkbuilderscope.c, which GtkBuilderCScope
+# uses to find the get_type() function of a type it doesn't know yet
+def type_name_mangle(name, split_first_cap):
+    symbol = ''
+
+    for i, c in enumerate(name):
+        upper = c == c.upper()
+
+        if (upper and ((i > 0 and name[i - 1] != name[i - 1].upper()) or
+                       (i == 1 and name[0] == name[0].upper() and split_first_cap))) or \
+           (i > 2 and upper and
+            name[i - 1] == name[i - 1].upper() and
+            name[i - 2] == name[i - 2].upper()):
+            symbol += '_'
+
+        symbol += c.lower()
+
+    return symbol + '_get_type'
+
+def can_resolve_lazily(type_name, get_type):
+    return get_type in (type_name_mangle(type_name, True),
+                        type_name_mangle(type_name, False))
+
+def main():
+    parser = argparse.ArgumentParser()
+    parser.add_argument('--lazy', action='store_true',
+                        help='Only register the types GtkBuilder cannot resolve by name')
+    parser.add_argument('headers', nargs='+')
+    args = parser.parse_args()
+
     ensure_types = []
+    type_names = {}
+    get_types = {}
     print('/* This file was generated by gen-public-types.py, do not edit it. */\n')
 
     # Run through the headers fed in to #include them and extract the ADW_TYPE_* macros
-    for header in argv[1:]:
+    for header in args.headers:
         print('#include "%s"' % os.path.basename(header))
         with open(header, 'r') as file:
             for line in file:
+                match = re.search(r'#define {1,}(ADW_TYPE_[A-Z0-9_]{1,}) {1,}\((\w+) *\(\)\)', line)
+                if match:
+                    ensure_types.append(match.group(1))
+                    get_types[match.group(1)] = match.group(2)
+                    continue
+
                 match = re.search(r'#define {1,}(ADW_TYPE_[A-Z0-9_]{1,}) {1,}.*', line)
                 if match:
                     ensure_types.append(match.group(1))
+                    continue
+
+                match = re.search(r'G_DECLARE_\w+ *\((\w+), *(\w+),', line)
+                if match:
+                    type_names[match.group(2) + '_get_type'] = match.group(1)
 
     ensure_types.sort()
 
+    if args.lazy:
+        # Types declared with G_DECLARE_* whose name mangles to their get_type()
+        # function are left for GtkBuilderCScope to register the first time a
+        # UI file mentions them. Enums, boxed types and anything with an
+        # irregular name are still registered here.
+        def is_eager(gtype):
+            get_type = get_types.get(gtype)
+            type_name = type_names.get(get_type)
+
+            return type_name is None or not can_resolve_lazily(type_name, get_type)
+
+        ensure_types = [gtype for gtype in ensure_types if is_eager(gtype)]
+
     print('#include "adw-main-private.h"\n')
     print('void')
     print('adw_init_public_types (void)')
@@ -29,4 +84,4 @@ def main(argv):
 
     print('}')
 
-main(sys.argv)
+main()
@@ -0,0 +1,203 @@
+#include <advaita.h>
+
+/* Types a query into the search entry of a preferences dialog with 2000 rows,
+ * one character per frame, then deletes it again, and prints how long each
+ * keystroke took to get on screen. */
+
+#define N_PAGES 10
+#define N_GROUPS 10
+#define N_ROWS 20
+
+static const char *queries[] = {
+  "r", "ro", "row", "row ", "row 1", "row 12",
+  "row 1", "row ", "row", "ro", "r", "",
+  "g", "gr", "group 7", "page 3", "",
+};
+
+typedef struct {
+  GtkWidget *window;
+  GtkEditable *entry;
+
+  guint n_typed;
+  gint64 type_start;
+  gboolean searched;
+
+  gint64 total_time;
+  gint64 max_time;
+
+  gboolean done;
+} SearchData;
+
+static GtkWidget *
+find_descendant_of_type (GtkWidget *widget,
+                         GType      type)
+{
+  GtkWidget *child;
+
+  if (G_TYPE_CHECK_INSTANCE_TYPE (widget, type))
+    return widget;
+
+  for (child = gtk_widget_get_first_child (widget);
+       child;
+       child = gtk_widget_get_next_sibling (child)) {
+    GtkWidget *ret = find_descendant_of_type (child, type);
+
+    if (ret)
+      return ret;
+  }
+
+  return NULL;
+}
+
+static void
+type_query (SearchData *data)
+{
+  data->type_start = g_get_monotonic_time ();
+  data->searched = FALSE;
+
+  gtk_editable_set_text (data->entry, queries[data->n_typed]);
+}
+
+static void
+search_changed_cb (SearchData *data)
+{
+  data->searched = TRUE;
+}
+
+static void
+after_paint_cb (GdkFrameClock *clock,
+                SearchData    *data)
+{
+  gint64 elapsed;
+
+  /* Wait for the frame that shows the results, not just the new text */
+  if (data->type_start < 0 || !data->searched)
+    return;
+
+  elapsed = g_get_monotonic_time () - data->type_start;
+  data->type_start = -1;
+
+  g_print ("\"%s\": %.2f ms\n", queries[data->n_typed], elapsed / 1000.0);
+
+  data->total_time += elapsed;
+  data->max_time = MAX (data->max_time, elapsed);
+
+  if (++data->n_typed < G_N_ELEMENTS (queries)) {
+    g_idle_add_once ((GSourceOnceFunc) type_query, data);
+    return;
+  }
+
+  g_signal_handlers_disconnect_by_func (clock, after_paint_cb, data);
+
+  g_print ("%u keystrokes: average %.2f ms, max %.2f ms\n",
+           data->n_typed,
+           data->total_time / (double) data->n_typed / 1000.0,
+           data->max_time / 1000.0);
+
+  gtk_window_destroy (GTK_WINDOW (data->window));
+}
+
+static void
+map_cb (GtkWidget  *window,
+        SearchData *data)
+{
+  GdkFrameClock *clock = gtk_widget_get_frame_clock (window);
+
+  g_signal_connect (clock, "after-paint", G_CALLBACK (after_paint_cb), data);
+
+  g_idle_add_once ((GSourceOnceFunc) type_query, data);
+}
+
+static AdwDialog *
+create_dialog (void)
+{
+  AdwDialog *dialog = ADW_DIALOG (adw_preferences_dialog_new ());
+  int i, j, k;
+
+  adw_preferences_dialog_set_search_enabled (ADW_PREFERENCES_DIALOG (dialog), TRUE);
+
+  for (i = 0; i < N_PAGES; i++) {
+    g_autofree char *page_title = g_strdup_printf ("Page %d", i);
+    GtkWidget *page = adw_preferences_page_new ();
+
+    adw_preferences_page_set_title (ADW_PREFERENCES_PAGE (page), page_title);
+    adw_preferences_page_set_icon_name (ADW_PREFERENCES_PAGE (page), "emblem-system-symbolic");
+
+    for (j = 0; j < N_GROUPS; j++) {
+      g_autofree char *group_title = g_strdup_printf ("Group %d", j);
+      GtkWidget *group = adw_preferences_group_new ();
+
+      adw_preferences_group_set_title (ADW_PREFERENCES_GROUP (group), group_title);
+
+      for (k = 0; k < N_ROWS; k++) {
+        int n = (i * N_GROUPS + j) * N_ROWS + k;
+        g_autofree char *title = g_strdup_printf ("Row %d", n);
+        g_autofree char *subtitle = g_strdup_printf ("Group %d, page %d", j, i);
+        GtkWidget *row = adw_switch_row_new ();
+
+        adw_preferences_row_set_title (ADW_PREFERENCES_ROW (row), title);
+        adw_action_row_set_subtitle (ADW_ACTION_ROW (row), subtitle);
+
+        adw_preferences_group_add (ADW_PREFERENCES_GROUP (group), row);
+      }
+
+      adw_preferences_page_add (ADW_PREFERENCES_PAGE (page),
+                                ADW_PREFERENCES_GROUP (group));
+    }
+
+    adw_preferences_dialog_add (ADW_PREFERENCES_DIALOG (dialog),
+                                ADW_PREFERENCES_PAGE (page));
+  }
+
+  return dialog;
+}
+
+static void
+close_cb (SearchData *data)
+{
+  data->done = TRUE;
+}
+
+int
+main (int   argc,
+      char *argv[])
+{
+  SearchData data = { 0 };
+  AdwDialog *dialog;
+  GtkWidget *entry;
+
+  adw_init ();
+
+  data.type_start = -1;
+
+  data.window = adw_window_new ();
+  gtk_window_set_title (GTK_WINDOW (data.window), "Preferences Search");
+  gtk_window_set_default_size (GTK_WINDOW (data.window), 800, 800);
+  adw_window_set_content (ADW_WINDOW (data.window), adw_status_page_new ());
+
+  dialog = create_dialog ();
+  adw_dialog_present (dialog, data.window);
+
+  /* The search entry is private, so look it up by type */
+  entry = find_descendant_of_type (GTK_WIDGET (dialog), GTK_TYPE_SEARCH_ENTRY);
+  g_assert (entry);
+
+  /* Measure the search itself rather than the typing delay */
+  gtk_search_entry_set_search_delay (GTK_SEARCH_ENTRY (entry), 0);
+  data.entry = GTK_EDITABLE (entry);
+
+  g_signal_connect_swapped (entry, "search-changed", G_CALLBACK (search_changed_cb), &data);
+
+  /* Switch the dialog to the search results, same as typing would */
+  g_signal_emit_by_name (entry, "search-started");
+
+  g_signal_connect (data.window, "map", G_CALLBACK (map_cb), &data);
+  g_signal_connect_swapped (data.window, "destroy", G_CALLBACK (close_cb), &data);
+
+  gtk_window_present (GTK_WINDOW (data.window));
+
+  while (!data.done)
+    g_main_context_iteration (NULL, TRUE);
+
+  return 0;
+}
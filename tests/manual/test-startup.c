@@ -0,0 +1,79 @@
+#include <advaita.h>
+
+/* Measures the time from process start to the first frame of a minimal
+ * AdwApplicationWindow. Run with ADW_DEBUG=startup to also see how much of it
+ * is spent in each phase of adw_init(). */
+
+static gint64 start_time;
+static gint64 init_time;
+
+static void
+after_paint_cb (GdkFrameClock *clock,
+                GtkWindow     *window)
+{
+  gint64 elapsed = g_get_monotonic_time () - start_time;
+
+  g_signal_handlers_disconnect_by_func (clock, after_paint_cb, window);
+
+  g_print ("adw_init: %.2f ms, first frame: %.2f ms\n",
+           init_time / 1000.0,
+           elapsed / 1000.0);
+
+  gtk_window_destroy (window);
+}
+
+static void
+map_cb (GtkWidget *window)
+{
+  GdkFrameClock *clock = gtk_widget_get_frame_clock (window);
+
+  g_signal_connect (clock, "after-paint", G_CALLBACK (after_paint_cb), window);
+}
+
+static void
+startup_cb (GApplication *app)
+{
+  init_time = g_get_monotonic_time () - start_time;
+}
+
+static void
+activate_cb (GtkApplication *app)
+{
+  GtkWidget *window, *toolbar_view;
+
+  toolbar_view = adw_toolbar_view_new ();
+  adw_toolbar_view_add_top_bar (ADW_TOOLBAR_VIEW (toolbar_view), adw_header_bar_new ());
+  adw_toolbar_view_set_content (ADW_TOOLBAR_VIEW (toolbar_view),
+                                adw_status_page_new ());
+
+  window = adw_application_window_new (app);
+  gtk_window_set_title (GTK_WINDOW (window), "Startup");
+  adw_application_window_set_content (ADW_APPLICATION_WINDOW (window), toolbar_view);
+
+  g_signal_connect (window, "map", G_CALLBACK (map_cb), NULL);
+
+  gtk_window_present (GTK_WINDOW (window));
+}
+
+int
+main (int   argc,
+      char *argv[])
+{
+  AdwApplication *app;
+  int ret;
+
+  start_time = g_get_monotonic_time ();
+
+  app = adw_application_new ("org.gnome.Advaita.TestStartup", G_APPLICATION_NON_UNIQUE);
+
+  /* AdwApplication calls adw_init() from its startup handler, so connect
+   * after it */
+  g_signal_connect_after (app, "startup", G_CALLBACK (startup_cb), NULL);
+  g_signal_connect (app, "activate", G_CALLBACK (activate_cb), NULL);
+
+  ret = g_application_run (G_APPLICATION (app), argc, argv);
+
+  g_object_unref (app);
+
+  return ret;
+}
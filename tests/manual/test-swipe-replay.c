@@ -0,0 +1,361 @@
+#include <advaita.h>
+#include "adw-swipe-tracker-private.h"
+
+/* Replays a drag against each swipeable widget, one event per frame, and
+ * prints how long the tracker took to handle each event, how long it took to
+ * get that event on screen, and where the gesture ended up.
+ *
+ * Pass a file recorded with ADW_SWIPE_RECORD=<file> to replay it instead of the
+ * built-in swipe. Since recordings use absolute coordinates, make sure the
+ * gesture makes sense for all of the widgets. */
+
+#define WINDOW_WIDTH 360
+#define WINDOW_HEIGHT 640
+#define N_SETTLE_FRAMES 30
+
+#define N_STEPS 24
+#define STEP_INTERVAL 8
+#define STEP_DISTANCE 12
+
+typedef struct {
+  const char *name;
+  AdwSwipeable *(* setup) (GtkWidget *window);
+
+  /* The built-in swipe, relative to the swipeable size */
+  double start_x;
+  double start_y;
+  double dx;
+  double dy;
+} Target;
+
+typedef struct {
+  const Target *target;
+  GArray *events;
+
+  GtkWidget *window;
+  AdwSwipeable *swipeable;
+  AdwSwipeTracker *tracker;
+
+  guint n_frames;
+  guint n_fed;
+
+  gint64 feed_start;
+  gint64 feed_total;
+  gint64 feed_max;
+  gint64 frame_total;
+  gint64 frame_max;
+  guint n_painted;
+
+  gboolean swiped;
+  double end_progress;
+
+  gboolean done;
+} ReplayData;
+
+static GtkWidget *
+create_page (const char *title)
+{
+  GtkWidget *page = adw_status_page_new ();
+
+  adw_status_page_set_title (ADW_STATUS_PAGE (page), title);
+  gtk_widget_set_size_request (page, 300, -1);
+
+  return page;
+}
+
+static AdwSwipeable *
+setup_carousel (GtkWidget *window)
+{
+  GtkWidget *carousel = adw_carousel_new ();
+
+  adw_carousel_append (ADW_CAROUSEL (carousel), create_page ("Page 1"));
+  adw_carousel_append (ADW_CAROUSEL (carousel), create_page ("Page 2"));
+  adw_carousel_append (ADW_CAROUSEL (carousel), create_page ("Page 3"));
+
+  adw_window_set_content (ADW_WINDOW (window), carousel);
+
+  return ADW_SWIPEABLE (carousel);
+}
+
+static AdwSwipeable *
+setup_navigation_view (GtkWidget *window)
+{
+  GtkWidget *view = adw_navigation_view_new ();
+  AdwNavigationPage *pages[2];
+
+  pages[0] = adw_navigation_page_new (create_page ("Page 1"), "Page 1");
+  pages[1] = adw_navigation_page_new (create_page ("Page 2"), "Page 2");
+
+  adw_navigation_view_replace (ADW_NAVIGATION_VIEW (view), pages, 2);
+
+  adw_window_set_content (ADW_WINDOW (window), view);
+
+  return ADW_SWIPEABLE (view);
+}
+
+static AdwSwipeable *
+setup_leaflet (GtkWidget *window)
+{
+  GtkWidget *leaflet, *page;
+
+G_GNUC_BEGIN_IGNORE_DEPRECATIONS
+  leaflet = adw_leaflet_new ();
+  adw_leaflet_set_can_navigate_back (ADW_LEAFLET (leaflet), TRUE);
+  adw_leaflet_append (ADW_LEAFLET (leaflet), create_page ("Page 1"));
+
+  page = create_page ("Page 2");
+  adw_leaflet_append (ADW_LEAFLET (leaflet), page);
+  adw_leaflet_set_visible_child (ADW_LEAFLET (leaflet), page);
+G_GNUC_END_IGNORE_DEPRECATIONS
+
+  adw_window_set_content (ADW_WINDOW (window), leaflet);
+
+  return ADW_SWIPEABLE (leaflet);
+}
+
+static GtkWidget *
+find_descendant_of_type (GtkWidget *widget,
+                         GType      type)
+{
+  GtkWidget *child;
+
+  if (G_TYPE_CHECK_INSTANCE_TYPE (widget, type))
+    return widget;
+
+  for (child = gtk_widget_get_first_child (widget);
+       child;
+       child = gtk_widget_get_next_sibling (child)) {
+    GtkWidget *ret = find_descendant_of_type (child, type);
+
+    if (ret)
+      return ret;
+  }
+
+  return NULL;
+}
+
+static AdwSwipeable *
+setup_bottom_sheet (GtkWidget *window)
+{
+  AdwDialog *dialog = adw_dialog_new ();
+  GtkWidget *sheet;
+
+  adw_window_set_content (ADW_WINDOW (window), create_page ("Window"));
+
+  adw_dialog_set_child (dialog, create_page ("Dialog"));
+  adw_dialog_set_content_height (dialog, 400);
+  adw_dialog_set_presentation_mode (dialog, ADW_DIALOG_BOTTOM_SHEET);
+  adw_dialog_present (dialog, window);
+
+  /* The bottom sheet is private, so look it up by name */
+  sheet = find_descendant_of_type (window, g_type_from_name ("AdwBottomSheet"));
+  g_assert (sheet);
+
+  return ADW_SWIPEABLE (sheet);
+}
+
+static const Target targets[] = {
+  { "AdwCarousel", setup_carousel, 0.5, 0.5, -1, 0 },
+  { "AdwNavigationView", setup_navigation_view, 0.5, 0.5, 1, 0 },
+  { "AdwLeaflet", setup_leaflet, 0.5, 0.5, 1, 0 },
+  { "AdwBottomSheet", setup_bottom_sheet, 0.5, 0.75, 0, 1 },
+};
+
+static GArray *
+create_builtin_events (ReplayData *data)
+{
+  GArray *events = g_array_new (FALSE, FALSE, sizeof (AdwSwipeEvent));
+  AdwSwipeEvent event;
+  int i;
+
+  event.type = ADW_SWIPE_EVENT_DRAG_BEGIN;
+  event.time = 1000;
+  event.x = gtk_widget_get_width (GTK_WIDGET (data->swipeable)) * data->target->start_x;
+  event.y = gtk_widget_get_height (GTK_WIDGET (data->swipeable)) * data->target->start_y;
+  g_array_append_val (events, event);
+
+  event.type = ADW_SWIPE_EVENT_DRAG_UPDATE;
+
+  for (i = 1; i <= N_STEPS; i++) {
+    event.time = 1000 + i * STEP_INTERVAL;
+    event.x = data->target->dx * STEP_DISTANCE * i;
+    event.y = data->target->dy * STEP_DISTANCE * i;
+    g_array_append_val (events, event);
+  }
+
+  event.type = ADW_SWIPE_EVENT_DRAG_END;
+  g_array_append_val (events, event);
+
+  return events;
+}
+
+static void
+end_swipe_cb (AdwSwipeTracker *tracker,
+              double           velocity,
+              double           to,
+              ReplayData      *data)
+{
+  data->swiped = TRUE;
+  data->end_progress = to;
+}
+
+static void
+print_results (ReplayData *data)
+{
+  g_print ("%s: %u events, handling avg %.2f µs max %.2f µs, "
+           "frame avg %.2f ms max %.2f ms, ",
+           data->target->name,
+           data->n_fed,
+           data->feed_total / (double) MAX (data->n_fed, 1),
+           (double) data->feed_max,
+           data->frame_total / (double) MAX (data->n_painted, 1) / 1000.0,
+           data->frame_max / 1000.0);
+
+  if (data->swiped)
+    g_print ("snapped to %g\n", data->end_progress);
+  else
+    g_print ("no swipe\n");
+}
+
+static void
+after_paint_cb (GdkFrameClock *clock,
+                ReplayData    *data)
+{
+  gint64 elapsed;
+
+  if (data->feed_start < 0)
+    return;
+
+  elapsed = g_get_monotonic_time () - data->feed_start;
+  data->feed_start = -1;
+
+  data->frame_total += elapsed;
+  data->frame_max = MAX (data->frame_max, elapsed);
+  data->n_painted++;
+
+  if (data->n_fed < data->events->len)
+    return;
+
+  g_signal_handlers_disconnect_by_func (clock, after_paint_cb, data);
+
+  print_results (data);
+
+  gtk_window_destroy (GTK_WINDOW (data->window));
+}
+
+static gboolean
+tick_cb (GtkWidget     *widget,
+         GdkFrameClock *clock,
+         ReplayData    *data)
+{
+  AdwSwipeEvent *event;
+  gint64 elapsed;
+
+  /* Let the window and any opening animations settle first */
+  if (++data->n_frames < N_SETTLE_FRAMES)
+    return G_SOURCE_CONTINUE;
+
+  if (!data->events)
+    data->events = create_builtin_events (data);
+
+  event = &g_array_index (data->events, AdwSwipeEvent, data->n_fed);
+
+  data->feed_start = g_get_monotonic_time ();
+  adw_swipe_tracker_feed_event (data->tracker, event);
+  elapsed = g_get_monotonic_time () - data->feed_start;
+
+  data->feed_total += elapsed;
+  data->feed_max = MAX (data->feed_max, elapsed);
+
+  gtk_widget_queue_draw (widget);
+
+  if (++data->n_fed < data->events->len)
+    return G_SOURCE_CONTINUE;
+
+  return G_SOURCE_REMOVE;
+}
+
+static void
+map_cb (GtkWidget  *window,
+        ReplayData *data)
+{
+  GdkFrameClock *clock = gtk_widget_get_frame_clock (window);
+
+  g_signal_connect (clock, "after-paint", G_CALLBACK (after_paint_cb), data);
+
+  gtk_widget_add_tick_callback (window, (GtkTickCallback) tick_cb, data, NULL);
+}
+
+static void
+close_cb (ReplayData *data)
+{
+  data->done = TRUE;
+}
+
+static void
+replay (const Target *target,
+        GArray       *events)
+{
+  ReplayData data = { 0 };
+
+  data.target = target;
+  data.events = events ? g_array_ref (events) : NULL;
+  data.feed_start = -1;
+
+  data.window = adw_window_new ();
+  gtk_window_set_title (GTK_WINDOW (data.window), target->name);
+  gtk_window_set_default_size (GTK_WINDOW (data.window), WINDOW_WIDTH, WINDOW_HEIGHT);
+
+  g_signal_connect (data.window, "map", G_CALLBACK (map_cb), &data);
+  g_signal_connect_swapped (data.window, "destroy", G_CALLBACK (close_cb), &data);
+
+  gtk_window_present (GTK_WINDOW (data.window));
+
+  data.swipeable = target->setup (data.window);
+  data.tracker = adw_swipe_tracker_get_for_swipeable (data.swipeable);
+  g_assert (data.tracker);
+
+  g_signal_connect (data.tracker, "end-swipe", G_CALLBACK (end_swipe_cb), &data);
+
+  while (!data.done)
+    g_main_context_iteration (NULL, TRUE);
+
+  g_array_unref (data.events);
+}
+
+int
+main (int   argc,
+      char *argv[])
+{
+  GArray *events = NULL;
+  gsize i;
+
+  adw_init ();
+
+  if (argc > 1) {
+    g_autofree char *contents = NULL;
+    GError *error = NULL;
+
+    if (!g_file_get_contents (argv[1], &contents, NULL, &error) ||
+        !(events = adw_swipe_events_parse (contents, &error))) {
+      g_printerr ("Couldn't load %s: %s\n", argv[1], error->message);
+      g_error_free (error);
+
+      return 1;
+    }
+
+    if (events->len == 0) {
+      g_printerr ("%s doesn't contain any events\n", argv[1]);
+      g_array_unref (events);
+
+      return 1;
+    }
+  }
+
+  for (i = 0; i < G_N_ELEMENTS (targets); i++)
+    replay (&targets[i], events);
+
+  g_clear_pointer (&events, g_array_unref);
+
+  return 0;
+}
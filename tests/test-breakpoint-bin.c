@@ -43,6 +43,131 @@ test_adw_breakpoint_bin_child (void)
   g_assert_finalize_object (bin);
 }
 
+static void
+test_adw_breakpoint_bin_snapshot_mode (void)
+{
+  AdwBreakpointBin *bin = g_object_ref_sink (ADW_BREAKPOINT_BIN (adw_breakpoint_bin_new ()));
+  AdwBreakpointSnapshotMode mode;
+  int notified = 0;
+
+  g_assert_nonnull (bin);
+
+  g_signal_connect_swapped (bin, "notify::snapshot-mode", G_CALLBACK (increment), &notified);
+
+  g_object_get (bin, "snapshot-mode", &mode, NULL);
+  g_assert_cmpint (mode, ==, ADW_BREAKPOINT_SNAPSHOT_FULL);
+
+  adw_breakpoint_bin_set_snapshot_mode (bin, ADW_BREAKPOINT_SNAPSHOT_FULL);
+  g_assert_cmpint (notified, ==, 0);
+
+  adw_breakpoint_bin_set_snapshot_mode (bin, ADW_BREAKPOINT_SNAPSHOT_TEXTURE);
+  g_assert_cmpint (adw_breakpoint_bin_get_snapshot_mode (bin), ==, ADW_BREAKPOINT_SNAPSHOT_TEXTURE);
+  g_assert_cmpint (notified, ==, 1);
+
+  g_object_set (bin, "snapshot-mode", ADW_BREAKPOINT_SNAPSHOT_NONE, NULL);
+  g_assert_cmpint (adw_breakpoint_bin_get_snapshot_mode (bin), ==, ADW_BREAKPOINT_SNAPSHOT_NONE);
+  g_assert_cmpint (notified, ==, 2);
+
+  g_assert_finalize_object (bin);
+}
+
+static void
+allocate (GtkWidget *widget,
+          int        width,
+          int        height)
+{
+  gtk_widget_measure (widget, GTK_ORIENTATION_HORIZONTAL, -1, NULL, NULL, NULL, NULL);
+  gtk_widget_measure (widget, GTK_ORIENTATION_VERTICAL, width, NULL, NULL, NULL, NULL);
+  gtk_widget_size_allocate (widget, &(GtkAllocation) { 0, 0, width, height }, -1);
+}
+
+/* While the old layout is kept on screen, the child is hidden until the next
+ * frame, so its visibility tells whether a snapshot was taken */
+static gboolean
+switch_takes_snapshot (AdwBreakpointSnapshotMode mode)
+{
+  AdwBreakpointBin *bin = g_object_ref_sink (ADW_BREAKPOINT_BIN (adw_breakpoint_bin_new ()));
+  AdwBreakpoint *breakpoint;
+  GtkWidget *child = gtk_button_new ();
+  gboolean ret;
+
+  breakpoint = adw_breakpoint_new (adw_breakpoint_condition_parse ("max-width: 400px"));
+
+  gtk_widget_set_size_request (GTK_WIDGET (bin), 100, 100);
+  adw_breakpoint_bin_set_child (bin, child);
+  adw_breakpoint_bin_add_breakpoint (bin, breakpoint);
+  adw_breakpoint_bin_set_snapshot_mode (bin, mode);
+
+  allocate (GTK_WIDGET (bin), 600, 400);
+  g_assert_null (adw_breakpoint_bin_get_current_breakpoint (bin));
+  g_assert_true (gtk_widget_get_child_visible (child));
+
+  allocate (GTK_WIDGET (bin), 300, 400);
+  g_assert_true (adw_breakpoint_bin_get_current_breakpoint (bin) == breakpoint);
+
+  ret = !gtk_widget_get_child_visible (child);
+
+  g_assert_finalize_object (bin);
+
+  return ret;
+}
+
+static void
+test_adw_breakpoint_bin_snapshot (void)
+{
+  GtkSettings *settings = gtk_settings_get_default ();
+
+  g_object_set (settings, "gtk-enable-animations", TRUE, NULL);
+
+  g_assert_true (switch_takes_snapshot (ADW_BREAKPOINT_SNAPSHOT_FULL));
+  g_assert_true (switch_takes_snapshot (ADW_BREAKPOINT_SNAPSHOT_TEXTURE));
+  g_assert_false (switch_takes_snapshot (ADW_BREAKPOINT_SNAPSHOT_NONE));
+
+  g_object_set (settings, "gtk-enable-animations", FALSE, NULL);
+
+  g_assert_false (switch_takes_snapshot (ADW_BREAKPOINT_SNAPSHOT_FULL));
+  g_assert_false (switch_takes_snapshot (ADW_BREAKPOINT_SNAPSHOT_TEXTURE));
+
+  g_object_set (settings, "gtk-enable-animations", TRUE, NULL);
+}
+
+static void
+test_adw_breakpoint_bin_nested (void)
+{
+  GtkWidget *window = gtk_window_new ();
+  GtkWidget *outer = adw_breakpoint_bin_new ();
+  GtkWidget *inner = adw_breakpoint_bin_new ();
+  AdwBreakpointCondition *condition;
+  AdwBreakpoint *outer_breakpoint, *inner_breakpoint;
+
+  condition = adw_breakpoint_condition_parse ("max-width: 500px");
+
+  outer_breakpoint = adw_breakpoint_new (adw_breakpoint_condition_copy (condition));
+  inner_breakpoint = adw_breakpoint_new (adw_breakpoint_condition_copy (condition));
+
+  adw_breakpoint_bin_add_breakpoint (ADW_BREAKPOINT_BIN (outer), outer_breakpoint);
+  adw_breakpoint_bin_add_breakpoint (ADW_BREAKPOINT_BIN (inner), inner_breakpoint);
+
+  gtk_widget_set_size_request (outer, 100, 100);
+  gtk_widget_set_size_request (inner, 100, 100);
+
+  adw_breakpoint_bin_set_child (ADW_BREAKPOINT_BIN (inner), gtk_button_new ());
+  adw_breakpoint_bin_set_child (ADW_BREAKPOINT_BIN (outer), inner);
+
+  gtk_window_set_default_size (GTK_WINDOW (window), 400, 300);
+  gtk_window_set_child (GTK_WINDOW (window), outer);
+
+  gtk_window_present (GTK_WINDOW (window));
+  gtk_test_widget_wait_for_draw (window);
+
+  g_assert_true (adw_breakpoint_bin_get_current_breakpoint (ADW_BREAKPOINT_BIN (outer)) == outer_breakpoint);
+  g_assert_true (adw_breakpoint_bin_get_current_breakpoint (ADW_BREAKPOINT_BIN (inner)) == inner_breakpoint);
+
+  adw_breakpoint_condition_free (condition);
+
+  gtk_window_destroy (GTK_WINDOW (window));
+}
+
 int
 main (int   argc,
       char *argv[])
@@ -51,6 +176,9 @@ main (int   argc,
   adw_init ();
 
   g_test_add_func ("/Advaita/BreakpointBin/child", test_adw_breakpoint_bin_child);
+  g_test_add_func ("/Advaita/BreakpointBin/snapshot_mode", test_adw_breakpoint_bin_snapshot_mode);
+  g_test_add_func ("/Advaita/BreakpointBin/snapshot", test_adw_breakpoint_bin_snapshot);
+  g_test_add_func ("/Advaita/BreakpointBin/nested", test_adw_breakpoint_bin_nested);
 
   return g_test_run ();
 }
@@ -198,6 +198,50 @@ test_adw_breakpoint_condition_parse (void)
   check_parse ("() or max-height: 200px",              NULL);
 }
 
+static void
+test_adw_breakpoint_condition_copy (void)
+{
+  AdwBreakpointCondition *condition, *copy;
+
+  condition = adw_breakpoint_condition_parse ("max-width: 400px and min-aspect-ratio: 4/3");
+  copy = adw_breakpoint_condition_copy (condition);
+
+  g_assert_nonnull (copy);
+
+  adw_breakpoint_condition_free (condition);
+
+  check_to_string (copy, "max-width: 400px and min-aspect-ratio: 4/3");
+}
+
+static void
+test_adw_breakpoint_condition_builder (void)
+{
+  const char *ui =
+    "<interface>"
+    "  <object class=\"AdwBreakpoint\" id=\"breakpoint\">"
+    "    <condition>max-width: 400sp</condition>"
+    "  </object>"
+    "</interface>";
+  GtkBuilder *builder_1 = gtk_builder_new_from_string (ui, -1);
+  GtkBuilder *builder_2 = gtk_builder_new_from_string (ui, -1);
+  AdwBreakpoint *breakpoint_1, *breakpoint_2;
+  AdwBreakpointCondition *condition_1, *condition_2;
+
+  breakpoint_1 = ADW_BREAKPOINT (gtk_builder_get_object (builder_1, "breakpoint"));
+  breakpoint_2 = ADW_BREAKPOINT (gtk_builder_get_object (builder_2, "breakpoint"));
+
+  condition_1 = adw_breakpoint_get_condition (breakpoint_1);
+  condition_2 = adw_breakpoint_get_condition (breakpoint_2);
+
+  g_assert_nonnull (condition_1);
+  g_assert_true (condition_1 == condition_2);
+
+  check_to_string (adw_breakpoint_condition_copy (condition_1), "max-width: 400sp");
+
+  g_object_unref (builder_1);
+  g_object_unref (builder_2);
+}
+
 int
 main (int   argc,
       char *argv[])
@@ -207,6 +251,8 @@ main (int   argc,
 
   g_test_add_func ("/Advaita/BreakpointCondition/to_string", test_adw_breakpoint_condition_to_string);
   g_test_add_func ("/Advaita/BreakpointCondition/parse", test_adw_breakpoint_condition_parse);
+  g_test_add_func ("/Advaita/BreakpointCondition/copy", test_adw_breakpoint_condition_copy);
+  g_test_add_func ("/Advaita/BreakpointCondition/builder", test_adw_breakpoint_condition_builder);
 
   return g_test_run ();
 }
@@ -41,6 +41,208 @@ test_adw_carousel_indicator_dots_carousel (void)
   g_assert_finalize_object (carousel);
 }
 
+static void
+test_adw_carousel_indicator_dots_measure (void)
+{
+  AdwCarouselIndicatorDots *dots = g_object_ref_sink (ADW_CAROUSEL_INDICATOR_DOTS (adw_carousel_indicator_dots_new ()));
+  AdwCarousel *carousel = g_object_ref_sink (ADW_CAROUSEL (adw_carousel_new ()));
+  const int n_pages[] = { 3, 20, 1000 };
+  int sizes[G_N_ELEMENTS (n_pages)];
+  int i, n = 0;
+
+  adw_carousel_indicator_dots_set_carousel (dots, carousel);
+
+  for (i = 0; i < G_N_ELEMENTS (n_pages); i++) {
+    for (; n < n_pages[i]; n++)
+      adw_carousel_append (carousel, gtk_label_new (""));
+
+    /* Snap points are only updated on allocation otherwise */
+    adw_carousel_scroll_to_nth_page (carousel, 0, FALSE);
+
+    gtk_widget_measure (GTK_WIDGET (dots), GTK_ORIENTATION_HORIZONTAL, -1, NULL, &sizes[i], NULL, NULL);
+  }
+
+  /* Past a certain number of pages the indicator stops growing */
+  g_assert_cmpint (sizes[0], <, sizes[1]);
+  g_assert_cmpint (sizes[1], ==, sizes[2]);
+
+  g_assert_finalize_object (dots);
+  g_assert_finalize_object (carousel);
+}
+
+static GskRenderNode *
+snapshot_indicator (GtkWidget *widget)
+{
+  GtkSnapshot *snapshot;
+  int width, height;
+
+  gtk_widget_measure (widget, GTK_ORIENTATION_HORIZONTAL, -1, NULL, &width, NULL, NULL);
+  gtk_widget_measure (widget, GTK_ORIENTATION_VERTICAL, width, NULL, &height, NULL, NULL);
+  gtk_widget_size_allocate (widget, &(GtkAllocation) { 0, 0, width, height }, -1);
+
+  snapshot = gtk_snapshot_new ();
+  GTK_WIDGET_GET_CLASS (widget)->snapshot (widget, snapshot);
+
+  return gtk_snapshot_free_to_node (snapshot);
+}
+
+/* Returns the dots drawn one by one, skipping the cached ones */
+static GPtrArray *
+get_animated_dots (GskRenderNode *node)
+{
+  GPtrArray *dots = g_ptr_array_new ();
+  guint i, n_children;
+
+  g_assert_cmpint (gsk_render_node_get_node_type (node), ==, GSK_CONTAINER_NODE);
+
+  n_children = gsk_container_node_get_n_children (node);
+
+  for (i = 0; i < n_children; i++) {
+    GskRenderNode *child = gsk_container_node_get_child (node, i);
+
+    if (gsk_render_node_get_node_type (child) == GSK_ROUNDED_CLIP_NODE)
+      g_ptr_array_add (dots, child);
+  }
+
+  return dots;
+}
+
+/* Returns the node the inactive dots are cached in */
+static GskRenderNode *
+get_static_dots (GskRenderNode *node)
+{
+  guint i, n_children;
+
+  g_assert_cmpint (gsk_render_node_get_node_type (node), ==, GSK_CONTAINER_NODE);
+
+  n_children = gsk_container_node_get_n_children (node);
+
+  for (i = 0; i < n_children; i++) {
+    GskRenderNode *child = gsk_container_node_get_child (node, i);
+
+    if (gsk_render_node_get_node_type (child) == GSK_CLIP_NODE)
+      return gsk_clip_node_get_child (child);
+  }
+
+  return NULL;
+}
+
+static double
+get_dot_start (GskRenderNode *dot)
+{
+  graphene_rect_t bounds;
+
+  gsk_render_node_get_bounds (dot, &bounds);
+
+  return bounds.origin.x;
+}
+
+static void
+assert_within_widget (GskRenderNode *node,
+                      GtkWidget     *widget)
+{
+  graphene_rect_t bounds;
+
+  gsk_render_node_get_bounds (node, &bounds);
+
+  g_assert_cmpfloat (bounds.origin.x, >=, 0);
+  g_assert_cmpfloat (bounds.origin.x + bounds.size.width, <=, gtk_widget_get_width (widget));
+}
+
+static void
+test_adw_carousel_indicator_dots_snapshot_static (void)
+{
+  AdwCarouselIndicatorDots *dots = g_object_ref_sink (ADW_CAROUSEL_INDICATOR_DOTS (adw_carousel_indicator_dots_new ()));
+  AdwCarousel *carousel = g_object_ref_sink (ADW_CAROUSEL (adw_carousel_new ()));
+  GskRenderNode *node, *static_dots;
+  GPtrArray *animated;
+  double active_start;
+  int i;
+
+  adw_carousel_indicator_dots_set_carousel (dots, carousel);
+
+  for (i = 0; i < 5; i++)
+    adw_carousel_append (carousel, gtk_label_new (""));
+
+  adw_carousel_scroll_to_nth_page (carousel, 0, FALSE);
+
+  /* Only the dots that can be active are drawn separately */
+  node = snapshot_indicator (GTK_WIDGET (dots));
+  animated = get_animated_dots (node);
+  g_assert_cmpuint (animated->len, ==, 2);
+  active_start = get_dot_start (g_ptr_array_index (animated, 0));
+  static_dots = gsk_render_node_ref (get_static_dots (node));
+  g_assert_cmpint (gsk_container_node_get_n_children (static_dots), ==, 5);
+  g_ptr_array_unref (animated);
+  gsk_render_node_unref (node);
+
+  /* Redrawing reuses the cached dots */
+  node = snapshot_indicator (GTK_WIDGET (dots));
+  g_assert_true (get_static_dots (node) == static_dots);
+  gsk_render_node_unref (node);
+
+  /* Moving only moves the active dots */
+  adw_carousel_scroll_to_nth_page (carousel, 2, FALSE);
+  node = snapshot_indicator (GTK_WIDGET (dots));
+  animated = get_animated_dots (node);
+  g_assert_cmpuint (animated->len, ==, 2);
+  g_assert_cmpfloat (get_dot_start (g_ptr_array_index (animated, 0)), >, active_start);
+  g_assert_true (get_static_dots (node) == static_dots);
+  g_ptr_array_unref (animated);
+  gsk_render_node_unref (node);
+
+  /* Adding a page invalidates them */
+  adw_carousel_append (carousel, gtk_label_new (""));
+  adw_carousel_scroll_to_nth_page (carousel, 2, FALSE);
+  node = snapshot_indicator (GTK_WIDGET (dots));
+  g_assert_false (get_static_dots (node) == static_dots);
+  g_assert_cmpint (gsk_container_node_get_n_children (get_static_dots (node)), ==, 6);
+  gsk_render_node_unref (node);
+
+  gsk_render_node_unref (static_dots);
+
+  g_assert_finalize_object (dots);
+  g_assert_finalize_object (carousel);
+}
+
+static void
+test_adw_carousel_indicator_dots_snapshot_windowed (void)
+{
+  AdwCarouselIndicatorDots *dots = g_object_ref_sink (ADW_CAROUSEL_INDICATOR_DOTS (adw_carousel_indicator_dots_new ()));
+  AdwCarousel *carousel = g_object_ref_sink (ADW_CAROUSEL (adw_carousel_new ()));
+  GskRenderNode *node;
+  GPtrArray *animated;
+  int i;
+
+  adw_carousel_indicator_dots_set_carousel (dots, carousel);
+
+  for (i = 0; i < 1000; i++)
+    adw_carousel_append (carousel, gtk_label_new (""));
+
+  adw_carousel_scroll_to_nth_page (carousel, 0, FALSE);
+
+  /* Only a window of dots is drawn, and nothing is cached */
+  node = snapshot_indicator (GTK_WIDGET (dots));
+  animated = get_animated_dots (node);
+  g_assert_cmpuint (animated->len, ==, 15);
+  g_assert_null (get_static_dots (node));
+  assert_within_widget (node, GTK_WIDGET (dots));
+  g_ptr_array_unref (animated);
+  gsk_render_node_unref (node);
+
+  /* The window follows the position and stays within the widget */
+  adw_carousel_scroll_to_nth_page (carousel, 500, FALSE);
+  node = snapshot_indicator (GTK_WIDGET (dots));
+  animated = get_animated_dots (node);
+  g_assert_cmpuint (animated->len, ==, 15);
+  assert_within_widget (node, GTK_WIDGET (dots));
+  g_ptr_array_unref (animated);
+  gsk_render_node_unref (node);
+
+  g_assert_finalize_object (dots);
+  g_assert_finalize_object (carousel);
+}
+
 int
 main (int   argc,
       char *argv[])
@@ -49,5 +251,8 @@ main (int   argc,
   adw_init ();
 
   g_test_add_func("/Advaita/CarouselIndicatorDots/carousel", test_adw_carousel_indicator_dots_carousel);
+  g_test_add_func("/Advaita/CarouselIndicatorDots/measure", test_adw_carousel_indicator_dots_measure);
+  g_test_add_func("/Advaita/CarouselIndicatorDots/snapshot_static", test_adw_carousel_indicator_dots_snapshot_static);
+  g_test_add_func("/Advaita/CarouselIndicatorDots/snapshot_windowed", test_adw_carousel_indicator_dots_snapshot_windowed);
   return g_test_run();
 }
@@ -41,6 +41,161 @@ test_adw_carousel_indicator_lines_carousel (void)
   g_assert_finalize_object (carousel);
 }
 
+static void
+test_adw_carousel_indicator_lines_measure (void)
+{
+  AdwCarouselIndicatorLines *lines = g_object_ref_sink (ADW_CAROUSEL_INDICATOR_LINES (adw_carousel_indicator_lines_new ()));
+  AdwCarousel *carousel = g_object_ref_sink (ADW_CAROUSEL (adw_carousel_new ()));
+  const int n_pages[] = { 3, 20, 1000 };
+  int sizes[G_N_ELEMENTS (n_pages)];
+  int i, n = 0;
+
+  adw_carousel_indicator_lines_set_carousel (lines, carousel);
+
+  for (i = 0; i < G_N_ELEMENTS (n_pages); i++) {
+    for (; n < n_pages[i]; n++)
+      adw_carousel_append (carousel, gtk_label_new (""));
+
+    /* Snap points are only updated on allocation otherwise */
+    adw_carousel_scroll_to_nth_page (carousel, 0, FALSE);
+
+    gtk_widget_measure (GTK_WIDGET (lines), GTK_ORIENTATION_HORIZONTAL, -1, NULL, &sizes[i], NULL, NULL);
+  }
+
+  /* Past a certain number of pages the indicator stops growing */
+  g_assert_cmpint (sizes[0], <, sizes[1]);
+  g_assert_cmpint (sizes[1], ==, sizes[2]);
+
+  g_assert_finalize_object (lines);
+  g_assert_finalize_object (carousel);
+}
+
+static GskRenderNode *
+snapshot_indicator (GtkWidget *widget)
+{
+  GtkSnapshot *snapshot;
+  int width, height;
+
+  gtk_widget_measure (widget, GTK_ORIENTATION_HORIZONTAL, -1, NULL, &width, NULL, NULL);
+  gtk_widget_measure (widget, GTK_ORIENTATION_VERTICAL, width, NULL, &height, NULL, NULL);
+  gtk_widget_size_allocate (widget, &(GtkAllocation) { 0, 0, width, height }, -1);
+
+  snapshot = gtk_snapshot_new ();
+  GTK_WIDGET_GET_CLASS (widget)->snapshot (widget, snapshot);
+
+  return gtk_snapshot_free_to_node (snapshot);
+}
+
+/* The inactive lines come first, then the active one */
+static GskRenderNode *
+get_line_node (GskRenderNode *node,
+               guint          index)
+{
+  g_assert_cmpint (gsk_render_node_get_node_type (node), ==, GSK_CONTAINER_NODE);
+  g_assert_cmpuint (gsk_container_node_get_n_children (node), ==, 2);
+
+  return gsk_container_node_get_child (node, index);
+}
+
+static double
+get_line_start (GskRenderNode *line)
+{
+  graphene_rect_t bounds;
+
+  g_assert_cmpint (gsk_render_node_get_node_type (line), ==, GSK_COLOR_NODE);
+
+  gsk_render_node_get_bounds (line, &bounds);
+
+  return bounds.origin.x;
+}
+
+static void
+test_adw_carousel_indicator_lines_snapshot_static (void)
+{
+  AdwCarouselIndicatorLines *lines = g_object_ref_sink (ADW_CAROUSEL_INDICATOR_LINES (adw_carousel_indicator_lines_new ()));
+  AdwCarousel *carousel = g_object_ref_sink (ADW_CAROUSEL (adw_carousel_new ()));
+  GskRenderNode *node, *static_lines;
+  double active_start;
+  int i;
+
+  adw_carousel_indicator_lines_set_carousel (lines, carousel);
+
+  for (i = 0; i < 5; i++)
+    adw_carousel_append (carousel, gtk_label_new (""));
+
+  adw_carousel_scroll_to_nth_page (carousel, 0, FALSE);
+
+  /* The inactive lines are drawn as one cached node */
+  node = snapshot_indicator (GTK_WIDGET (lines));
+  static_lines = gsk_render_node_ref (get_line_node (node, 0));
+  g_assert_cmpint (gsk_render_node_get_node_type (static_lines), ==, GSK_CONTAINER_NODE);
+  g_assert_cmpuint (gsk_container_node_get_n_children (static_lines), ==, 5);
+  active_start = get_line_start (get_line_node (node, 1));
+  gsk_render_node_unref (node);
+
+  /* Redrawing reuses it */
+  node = snapshot_indicator (GTK_WIDGET (lines));
+  g_assert_true (get_line_node (node, 0) == static_lines);
+  gsk_render_node_unref (node);
+
+  /* Moving only moves the active line */
+  adw_carousel_scroll_to_nth_page (carousel, 2, FALSE);
+  node = snapshot_indicator (GTK_WIDGET (lines));
+  g_assert_true (get_line_node (node, 0) == static_lines);
+  g_assert_cmpfloat (get_line_start (get_line_node (node, 1)), >, active_start);
+  gsk_render_node_unref (node);
+
+  /* Adding a page invalidates it */
+  adw_carousel_append (carousel, gtk_label_new (""));
+  adw_carousel_scroll_to_nth_page (carousel, 2, FALSE);
+  node = snapshot_indicator (GTK_WIDGET (lines));
+  g_assert_false (get_line_node (node, 0) == static_lines);
+  g_assert_cmpuint (gsk_container_node_get_n_children (get_line_node (node, 0)), ==, 6);
+  gsk_render_node_unref (node);
+
+  gsk_render_node_unref (static_lines);
+
+  g_assert_finalize_object (lines);
+  g_assert_finalize_object (carousel);
+}
+
+static void
+test_adw_carousel_indicator_lines_snapshot_scaled (void)
+{
+  AdwCarouselIndicatorLines *lines = g_object_ref_sink (ADW_CAROUSEL_INDICATOR_LINES (adw_carousel_indicator_lines_new ()));
+  AdwCarousel *carousel = g_object_ref_sink (ADW_CAROUSEL (adw_carousel_new ()));
+  GskRenderNode *node;
+  graphene_rect_t bounds;
+  double active_start;
+  int i;
+
+  adw_carousel_indicator_lines_set_carousel (lines, carousel);
+
+  for (i = 0; i < 1000; i++)
+    adw_carousel_append (carousel, gtk_label_new (""));
+
+  adw_carousel_scroll_to_nth_page (carousel, 0, FALSE);
+
+  /* A single track and a single active line, regardless of the page count */
+  node = snapshot_indicator (GTK_WIDGET (lines));
+  g_assert_cmpint (gsk_render_node_get_node_type (get_line_node (node, 0)), ==, GSK_COLOR_NODE);
+  active_start = get_line_start (get_line_node (node, 1));
+
+  gsk_render_node_get_bounds (node, &bounds);
+  g_assert_cmpfloat (bounds.origin.x, >=, 0);
+  g_assert_cmpfloat (bounds.origin.x + bounds.size.width, <=, gtk_widget_get_width (GTK_WIDGET (lines)));
+  gsk_render_node_unref (node);
+
+  /* The active line moves along the track */
+  adw_carousel_scroll_to_nth_page (carousel, 500, FALSE);
+  node = snapshot_indicator (GTK_WIDGET (lines));
+  g_assert_cmpfloat (get_line_start (get_line_node (node, 1)), >, active_start);
+  gsk_render_node_unref (node);
+
+  g_assert_finalize_object (lines);
+  g_assert_finalize_object (carousel);
+}
+
 int
 main (int   argc,
       char *argv[])
@@ -49,5 +204,8 @@ main (int   argc,
   adw_init ();
 
   g_test_add_func("/Advaita/CarouselInidicatorLines/carousel", test_adw_carousel_indicator_lines_carousel);
+  g_test_add_func("/Advaita/CarouselInidicatorLines/measure", test_adw_carousel_indicator_lines_measure);
+  g_test_add_func("/Advaita/CarouselInidicatorLines/snapshot_static", test_adw_carousel_indicator_lines_snapshot_static);
+  g_test_add_func("/Advaita/CarouselInidicatorLines/snapshot_scaled", test_adw_carousel_indicator_lines_snapshot_scaled);
   return g_test_run();
 }
@@ -296,6 +296,254 @@ test_adw_carousel_reveal_duration (void)
   g_assert_finalize_object (carousel);
 }
 
+static void
+test_adw_carousel_preload_pages (void)
+{
+  AdwCarousel *carousel = g_object_ref_sink (ADW_CAROUSEL (adw_carousel_new ()));
+  guint preload_pages;
+  int notified = 0;
+
+  g_signal_connect_swapped (carousel, "notify::preload-pages", G_CALLBACK (increment), &notified);
+
+  /* Accessors */
+  g_assert_cmpuint (adw_carousel_get_preload_pages (carousel), ==, 1);
+  adw_carousel_set_preload_pages (carousel, 2);
+  g_assert_cmpuint (adw_carousel_get_preload_pages (carousel), ==, 2);
+  g_assert_cmpint (notified, ==, 1);
+
+  /* Property */
+  g_object_set (carousel, "preload-pages", 0, NULL);
+  g_object_get (carousel, "preload-pages", &preload_pages, NULL);
+  g_assert_cmpuint (preload_pages, ==, 0);
+  g_assert_cmpint (notified, ==, 2);
+
+  /* Setting the same value should not notify */
+  adw_carousel_set_preload_pages (carousel, 0);
+  g_assert_cmpint (notified, ==, 2);
+
+  g_assert_finalize_object (carousel);
+}
+
+typedef struct {
+  int n_created;
+  int n_recycled;
+} PageStats;
+
+static GtkWidget *
+create_page_cb (GtkStringObject *item,
+                GtkWidget       *recycled,
+                PageStats       *stats)
+{
+  const char *label = gtk_string_object_get_string (item);
+
+  if (recycled) {
+    stats->n_recycled++;
+    gtk_label_set_label (GTK_LABEL (recycled), label);
+
+    return recycled;
+  }
+
+  stats->n_created++;
+
+  return gtk_label_new (label);
+}
+
+static int
+count_pages (AdwCarousel *carousel,
+             GListModel  *model)
+{
+  guint i, n_pages = adw_carousel_get_n_pages (carousel);
+  int n_created = 0;
+
+  g_assert_cmpuint (n_pages, ==, g_list_model_get_n_items (model));
+
+  for (i = 0; i < n_pages; i++) {
+    GtkWidget *page = adw_carousel_get_nth_page (carousel, i);
+    GtkStringObject *item;
+
+    if (!page)
+      continue;
+
+    /* Every page must show its own item */
+    item = g_list_model_get_item (model, i);
+    g_assert_cmpstr (gtk_label_get_label (GTK_LABEL (page)), ==,
+                     gtk_string_object_get_string (item));
+    g_object_unref (item);
+
+    n_created++;
+  }
+
+  return n_created;
+}
+
+static void
+test_adw_carousel_bind_model (void)
+{
+  AdwCarousel *carousel = g_object_ref_sink (ADW_CAROUSEL (adw_carousel_new ()));
+  GtkStringList *list = gtk_string_list_new (NULL);
+  GListModel *model = G_LIST_MODEL (list);
+  const char *added[] = { "Added", NULL };
+  PageStats stats = { 0 };
+  int notified = 0;
+  int i;
+
+  for (i = 0; i < 1000; i++) {
+    g_autofree char *string = g_strdup_printf ("%d", i);
+
+    gtk_string_list_append (list, string);
+  }
+
+  g_signal_connect_swapped (carousel, "notify::n-pages", G_CALLBACK (increment), &notified);
+
+  adw_carousel_bind_model (carousel, model,
+                           (AdwCarouselCreatePageFunc) create_page_cb,
+                           &stats, NULL);
+
+  g_assert_cmpuint (adw_carousel_get_n_pages (carousel), ==, 1000);
+  g_assert_cmpint (notified, ==, 1);
+
+  /* Only the current page and its neighbor exist */
+  g_assert_cmpint (count_pages (carousel, model), ==, 2);
+  g_assert_nonnull (adw_carousel_get_nth_page (carousel, 0));
+  g_assert_null (adw_carousel_get_nth_page (carousel, 2));
+  g_assert_cmpint (stats.n_created, ==, 2);
+
+  /* Both old pages get recycled, and only one new one is needed */
+  adw_carousel_scroll_to_nth_page (carousel, 500, FALSE);
+  g_assert_cmpfloat_with_epsilon (adw_carousel_get_position (carousel), 500, DBL_EPSILON);
+  g_assert_cmpint (count_pages (carousel, model), ==, 3);
+  g_assert_nonnull (adw_carousel_get_nth_page (carousel, 500));
+  g_assert_cmpint (stats.n_created, ==, 3);
+  g_assert_cmpint (stats.n_recycled, ==, 2);
+
+  adw_carousel_set_preload_pages (carousel, 2);
+  g_assert_cmpint (count_pages (carousel, model), ==, 5);
+
+  /* Model changes */
+  gtk_string_list_remove (list, 0);
+  g_assert_cmpuint (adw_carousel_get_n_pages (carousel), ==, 999);
+  g_assert_cmpint (notified, ==, 2);
+  count_pages (carousel, model);
+
+  gtk_string_list_splice (list, 500, 0, added);
+  g_assert_cmpuint (adw_carousel_get_n_pages (carousel), ==, 1000);
+  g_assert_cmpint (notified, ==, 3);
+  count_pages (carousel, model);
+
+  adw_carousel_bind_model (carousel, NULL, NULL, NULL, NULL);
+  g_assert_cmpuint (adw_carousel_get_n_pages (carousel), ==, 0);
+  g_assert_null (gtk_widget_get_first_child (GTK_WIDGET (carousel)));
+  g_assert_cmpint (notified, ==, 4);
+
+  g_assert_finalize_object (carousel);
+  g_assert_finalize_object (list);
+}
+
+static void
+prepare_page_cb (AdwCarousel *carousel,
+                 guint        index,
+                 double       distance,
+                 GArray      *prepared)
+{
+  g_array_append_val (prepared, index);
+}
+
+static GtkWidget *
+create_page_or_null_cb (GtkStringObject *item,
+                        GtkWidget       *recycled,
+                        gpointer         user_data)
+{
+  const char *label = gtk_string_object_get_string (item);
+
+  if (g_str_equal (label, "1"))
+    return NULL;
+
+  return gtk_label_new (label);
+}
+
+static void
+test_adw_carousel_bind_model_invalid_page (void)
+{
+  AdwCarousel *carousel = g_object_ref_sink (ADW_CAROUSEL (adw_carousel_new ()));
+  const char *strings[] = { "0", "1", "2", NULL };
+  GtkStringList *list = gtk_string_list_new (strings);
+
+  /* A broken callback must not take the whole app down */
+  g_test_expect_message (ADW_LOG_DOMAIN, G_LOG_LEVEL_CRITICAL,
+                         "*didn't return a widget for page 1*");
+  adw_carousel_bind_model (carousel, G_LIST_MODEL (list),
+                           (AdwCarouselCreatePageFunc) create_page_or_null_cb,
+                           NULL, NULL);
+  g_test_assert_expected_messages ();
+
+  g_assert_cmpuint (adw_carousel_get_n_pages (carousel), ==, 3);
+  g_assert_nonnull (adw_carousel_get_nth_page (carousel, 0));
+  g_assert_null (adw_carousel_get_nth_page (carousel, 1));
+
+  adw_carousel_bind_model (carousel, NULL, NULL, NULL, NULL);
+
+  g_assert_finalize_object (carousel);
+  g_assert_finalize_object (list);
+}
+
+static void
+test_adw_carousel_prepare_page (void)
+{
+  AdwCarousel *carousel = g_object_ref_sink (ADW_CAROUSEL (adw_carousel_new ()));
+  GArray *prepared = g_array_new (FALSE, FALSE, sizeof (guint));
+  guint prepare_radius;
+  int notified = 0;
+  int i;
+
+  g_signal_connect (carousel, "prepare-page", G_CALLBACK (prepare_page_cb), prepared);
+  g_signal_connect_swapped (carousel, "notify::prepare-radius", G_CALLBACK (increment), &notified);
+
+  for (i = 0; i < 5; i++)
+    adw_carousel_append (carousel, gtk_label_new (""));
+
+  /* The first page and its neighbor */
+  g_assert_cmpuint (prepared->len, ==, 2);
+  g_assert_cmpuint (g_array_index (prepared, guint, 0), ==, 0);
+  g_assert_cmpuint (g_array_index (prepared, guint, 1), ==, 1);
+
+  /* The destination is prepared before the scroll starts, and the pages
+   * in between are never close enough */
+  g_array_set_size (prepared, 0);
+  adw_carousel_scroll_to_nth_page (carousel, 4, FALSE);
+  g_assert_cmpuint (prepared->len, ==, 2);
+  g_assert_cmpuint (g_array_index (prepared, guint, 0), ==, 3);
+  g_assert_cmpuint (g_array_index (prepared, guint, 1), ==, 4);
+
+  /* Pages that left the radius are prepared again */
+  g_array_set_size (prepared, 0);
+  adw_carousel_scroll_to_nth_page (carousel, 0, FALSE);
+  g_assert_cmpuint (prepared->len, ==, 2);
+  g_assert_cmpuint (g_array_index (prepared, guint, 0), ==, 0);
+  g_assert_cmpuint (g_array_index (prepared, guint, 1), ==, 1);
+
+  /* Accessors */
+  g_array_set_size (prepared, 0);
+  g_assert_cmpuint (adw_carousel_get_prepare_radius (carousel), ==, 1);
+  adw_carousel_set_prepare_radius (carousel, 2);
+  g_assert_cmpuint (adw_carousel_get_prepare_radius (carousel), ==, 2);
+  g_assert_cmpint (notified, ==, 1);
+  g_assert_cmpuint (prepared->len, ==, 1);
+  g_assert_cmpuint (g_array_index (prepared, guint, 0), ==, 2);
+
+  /* Property */
+  g_object_set (carousel, "prepare-radius", 0, NULL);
+  g_object_get (carousel, "prepare-radius", &prepare_radius, NULL);
+  g_assert_cmpuint (prepare_radius, ==, 0);
+  g_assert_cmpint (notified, ==, 2);
+
+  /* Setting the same value should not notify */
+  adw_carousel_set_prepare_radius (carousel, 0);
+  g_assert_cmpint (notified, ==, 2);
+
+  g_assert_finalize_object (carousel);
+  g_array_unref (prepared);
+}
+
 int
 main (int   argc,
       char *argv[])
@@ -310,5 +558,9 @@ main (int   argc,
   g_test_add_func("/Advaita/Carousel/allow_mouse_drag", test_adw_carousel_allow_mouse_drag);
   g_test_add_func("/Advaita/Carousel/allow_long_swipes", test_adw_carousel_allow_long_swipes);
   g_test_add_func("/Advaita/Carousel/reveal_duration", test_adw_carousel_reveal_duration);
+  g_test_add_func("/Advaita/Carousel/preload_pages", test_adw_carousel_preload_pages);
+  g_test_add_func("/Advaita/Carousel/bind_model", test_adw_carousel_bind_model);
+  g_test_add_func("/Advaita/Carousel/bind_model_invalid_page", test_adw_carousel_bind_model_invalid_page);
+  g_test_add_func("/Advaita/Carousel/prepare_page", test_adw_carousel_prepare_page);
   return g_test_run();
 }
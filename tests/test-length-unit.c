@@ -0,0 +1,119 @@
+/*
+ * Copyright (C) 2024 GNOME Foundation, Inc.
+ *
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#include <advaita.h>
+
+static const double test_values[] = { 0, 1, 12.5, -3, 100, 1234.75 };
+
+static void
+set_dpi (GtkSettings *settings,
+         int          dpi)
+{
+  g_object_set (settings, "gtk-xft-dpi", dpi * PANGO_SCALE, NULL);
+}
+
+static void
+check_arrays (AdwLengthUnit  unit,
+              GtkSettings   *settings)
+{
+  double px_values[G_N_ELEMENTS (test_values)];
+  double values[G_N_ELEMENTS (test_values)];
+  gsize i;
+
+  adw_length_unit_to_px_array (unit, test_values, G_N_ELEMENTS (test_values),
+                               px_values, settings);
+
+  for (i = 0; i < G_N_ELEMENTS (test_values); i++) {
+    g_assert_cmpfloat_with_epsilon (px_values[i],
+                                    adw_length_unit_to_px (unit, test_values[i], settings),
+                                    DBL_EPSILON);
+  }
+
+  adw_length_unit_from_px_array (unit, test_values, G_N_ELEMENTS (test_values),
+                                 values, settings);
+
+  for (i = 0; i < G_N_ELEMENTS (test_values); i++) {
+    g_assert_cmpfloat_with_epsilon (values[i],
+                                    adw_length_unit_from_px (unit, test_values[i], settings),
+                                    DBL_EPSILON);
+  }
+
+  /* Converting in place must give the same results */
+  memcpy (values, test_values, sizeof (test_values));
+  adw_length_unit_to_px_array (unit, values, G_N_ELEMENTS (values), values, settings);
+
+  for (i = 0; i < G_N_ELEMENTS (test_values); i++)
+    g_assert_cmpfloat_with_epsilon (values[i], px_values[i], DBL_EPSILON);
+
+  adw_length_unit_from_px_array (unit, values, G_N_ELEMENTS (values), values, settings);
+
+  for (i = 0; i < G_N_ELEMENTS (test_values); i++)
+    g_assert_cmpfloat_with_epsilon (values[i], test_values[i], 0.0001);
+}
+
+static void
+test_adw_length_unit_arrays (void)
+{
+  GtkSettings *settings = gtk_settings_get_default ();
+
+  set_dpi (settings, 96);
+
+  check_arrays (ADW_LENGTH_UNIT_PX, settings);
+  check_arrays (ADW_LENGTH_UNIT_PT, settings);
+  check_arrays (ADW_LENGTH_UNIT_SP, settings);
+
+  set_dpi (settings, 120);
+
+  check_arrays (ADW_LENGTH_UNIT_PX, settings);
+  check_arrays (ADW_LENGTH_UNIT_PT, settings);
+  check_arrays (ADW_LENGTH_UNIT_SP, settings);
+
+  /* NULL means the default settings */
+  check_arrays (ADW_LENGTH_UNIT_SP, NULL);
+}
+
+static void
+test_adw_length_unit_dpi_changed (void)
+{
+  GtkSettings *settings = gtk_settings_get_default ();
+  double value = 10, px_value;
+
+  set_dpi (settings, 96);
+
+  g_assert_cmpfloat_with_epsilon (adw_length_unit_to_px (ADW_LENGTH_UNIT_PX, 10, settings), 10, DBL_EPSILON);
+  g_assert_cmpfloat_with_epsilon (adw_length_unit_to_px (ADW_LENGTH_UNIT_PT, 9, settings), 12, DBL_EPSILON);
+  g_assert_cmpfloat_with_epsilon (adw_length_unit_to_px (ADW_LENGTH_UNIT_SP, 10, settings), 10, DBL_EPSILON);
+  g_assert_cmpfloat_with_epsilon (adw_length_unit_from_px (ADW_LENGTH_UNIT_SP, 10, settings), 10, DBL_EPSILON);
+
+  /* The DPI is cached, changing it must invalidate the cache */
+  set_dpi (settings, 192);
+
+  g_assert_cmpfloat_with_epsilon (adw_length_unit_to_px (ADW_LENGTH_UNIT_PX, 10, settings), 10, DBL_EPSILON);
+  g_assert_cmpfloat_with_epsilon (adw_length_unit_to_px (ADW_LENGTH_UNIT_PT, 9, settings), 24, DBL_EPSILON);
+  g_assert_cmpfloat_with_epsilon (adw_length_unit_to_px (ADW_LENGTH_UNIT_SP, 10, settings), 20, DBL_EPSILON);
+  g_assert_cmpfloat_with_epsilon (adw_length_unit_from_px (ADW_LENGTH_UNIT_SP, 10, settings), 5, DBL_EPSILON);
+
+  adw_length_unit_to_px_array (ADW_LENGTH_UNIT_SP, &value, 1, &px_value, settings);
+  g_assert_cmpfloat_with_epsilon (px_value, 20, DBL_EPSILON);
+
+  set_dpi (settings, 96);
+
+  adw_length_unit_to_px_array (ADW_LENGTH_UNIT_SP, &value, 1, &px_value, settings);
+  g_assert_cmpfloat_with_epsilon (px_value, 10, DBL_EPSILON);
+}
+
+int
+main (int   argc,
+      char *argv[])
+{
+  gtk_test_init (&argc, &argv, NULL);
+  adw_init ();
+
+  g_test_add_func ("/Advaita/LengthUnit/arrays", test_adw_length_unit_arrays);
+  g_test_add_func ("/Advaita/LengthUnit/dpi_changed", test_adw_length_unit_dpi_changed);
+
+  return g_test_run ();
+}
@@ -598,6 +598,154 @@ test_adw_navigation_view_pop_on_escape (void)
   g_assert_finalize_object (view);
 }
 
+static void
+test_adw_navigation_view_cache_transitions (void)
+{
+  AdwNavigationView *view = g_object_ref_sink (ADW_NAVIGATION_VIEW (adw_navigation_view_new ()));
+  gboolean cache_transitions;
+  int notified = 0;
+
+  g_assert_nonnull (view);
+
+  g_signal_connect_swapped (view, "notify::cache-transitions", G_CALLBACK (increment), &notified);
+
+  g_object_get (view, "cache-transitions", &cache_transitions, NULL);
+  g_assert_false (cache_transitions);
+
+  adw_navigation_view_set_cache_transitions (view, FALSE);
+  g_assert_cmpint (notified, ==, 0);
+
+  adw_navigation_view_set_cache_transitions (view, TRUE);
+  g_assert_true (adw_navigation_view_get_cache_transitions (view));
+  g_assert_cmpint (notified, ==, 1);
+
+  g_object_set (view, "cache-transitions", FALSE, NULL);
+  g_assert_false (adw_navigation_view_get_cache_transitions (view));
+  g_assert_cmpint (notified, ==, 2);
+
+  g_assert_finalize_object (view);
+}
+
+static GtkWidget *
+create_child (AdwNavigationPage *page,
+              int               *n_created)
+{
+  GtkWidget *box = gtk_box_new (GTK_ORIENTATION_VERTICAL, 0);
+
+  (*n_created)++;
+
+  gtk_box_append (GTK_BOX (box), gtk_button_new ());
+  gtk_box_append (GTK_BOX (box), gtk_button_new ());
+
+  return box;
+}
+
+static AdwNavigationPage *
+create_lazy_page (const char *title,
+                  const char *tag,
+                  int        *n_created)
+{
+  AdwNavigationPage *page = g_object_new (ADW_TYPE_NAVIGATION_PAGE,
+                                          "title", title,
+                                          "tag", tag,
+                                          NULL);
+
+  adw_navigation_page_set_child_func (page, (AdwNavigationPageChildFunc) create_child, n_created, NULL);
+
+  return g_object_ref_sink (page);
+}
+
+static void
+test_adw_navigation_view_retention_depth (void)
+{
+  GtkWidget *window = gtk_window_new ();
+  AdwNavigationView *view = ADW_NAVIGATION_VIEW (adw_navigation_view_new ());
+  AdwNavigationPage *page_1, *page_2, *page_3;
+  GtkWidget *focus, *child;
+  int notified = 0, n_created = 0;
+
+  g_assert_nonnull (view);
+
+  page_1 = create_lazy_page ("Page 1", "page-1", &n_created);
+  page_2 = create_lazy_page ("Page 2", "page-2", &n_created);
+  page_3 = create_lazy_page ("Page 3", "page-3", &n_created);
+
+  g_signal_connect_swapped (view, "notify::retention-depth", G_CALLBACK (increment), &notified);
+
+  g_assert_cmpint (adw_navigation_view_get_retention_depth (view), ==, -1);
+
+  adw_navigation_view_set_retention_depth (view, -1);
+  g_assert_cmpint (notified, ==, 0);
+
+  g_object_set (view, "retention-depth", 1, NULL);
+  g_assert_cmpint (adw_navigation_view_get_retention_depth (view), ==, 1);
+  g_assert_cmpint (notified, ==, 1);
+
+  adw_navigation_view_set_animate_transitions (view, FALSE);
+
+  gtk_window_set_child (GTK_WINDOW (window), GTK_WIDGET (view));
+  gtk_window_present (GTK_WINDOW (window));
+  gtk_test_widget_wait_for_draw (window);
+
+  /* Children are created when the page is shown */
+  g_assert_null (adw_navigation_page_get_child (page_1));
+
+  adw_navigation_view_push (view, page_1);
+  g_assert_nonnull (adw_navigation_page_get_child (page_1));
+  g_assert_cmpint (n_created, ==, 1);
+  g_assert_true (gtk_widget_get_realized (GTK_WIDGET (page_1)));
+  g_assert_cmpuint (adw_navigation_view_get_n_realized_pages (view), ==, 1);
+
+  focus = gtk_widget_get_last_child (adw_navigation_page_get_child (page_1));
+  gtk_widget_grab_focus (focus);
+  g_assert_true (gtk_root_get_focus (GTK_ROOT (window)) == focus);
+
+  adw_navigation_view_push (view, page_2);
+  g_assert_nonnull (adw_navigation_page_get_child (page_1));
+  g_assert_nonnull (adw_navigation_page_get_child (page_2));
+  g_assert_cmpint (n_created, ==, 2);
+  g_assert_true (gtk_widget_get_realized (GTK_WIDGET (page_1)));
+  g_assert_cmpuint (adw_navigation_view_get_n_realized_pages (view), ==, 2);
+
+  child = adw_navigation_page_get_child (page_1);
+  g_object_add_weak_pointer (G_OBJECT (child), (gpointer *) &child);
+
+  /* Page 1 is now 2 levels below the visible page, so it's released */
+  adw_navigation_view_push (view, page_3);
+  g_assert_null (adw_navigation_page_get_child (page_1));
+  g_assert_null (child);
+  g_assert_nonnull (adw_navigation_page_get_child (page_2));
+  g_assert_cmpint (n_created, ==, 3);
+  g_assert_false (gtk_widget_get_realized (GTK_WIDGET (page_1)));
+  g_assert_true (gtk_widget_get_realized (GTK_WIDGET (page_2)));
+  g_assert_true (gtk_widget_get_realized (GTK_WIDGET (page_3)));
+  g_assert_cmpuint (adw_navigation_view_get_n_realized_pages (view), ==, 2);
+
+  /* The child is only created again once the page is shown */
+  adw_navigation_view_pop (view);
+  g_assert_null (adw_navigation_page_get_child (page_1));
+  g_assert_cmpint (n_created, ==, 3);
+
+  adw_navigation_view_pop (view);
+  g_assert_true (adw_navigation_view_get_visible_page (view) == page_1);
+  g_assert_nonnull (adw_navigation_page_get_child (page_1));
+  g_assert_cmpstr (adw_navigation_page_get_tag (page_1), ==, "page-1");
+  g_assert_cmpstr (adw_navigation_page_get_title (page_1), ==, "Page 1");
+  g_assert_cmpint (n_created, ==, 4);
+  g_assert_true (gtk_widget_get_realized (GTK_WIDGET (page_1)));
+  g_assert_cmpuint (adw_navigation_view_get_n_realized_pages (view), ==, 1);
+
+  /* The focus goes to the same place in the recreated child */
+  focus = gtk_widget_get_last_child (adw_navigation_page_get_child (page_1));
+  g_assert_true (gtk_root_get_focus (GTK_ROOT (window)) == focus);
+
+  gtk_window_destroy (GTK_WINDOW (window));
+
+  g_assert_finalize_object (page_1);
+  g_assert_finalize_object (page_2);
+  g_assert_finalize_object (page_3);
+}
+
 static void
 test_adw_navigation_page_child (void)
 {
@@ -801,6 +949,8 @@ main (int   argc,
   g_test_add_func ("/Advaita/NavigationView/find_page", test_adw_navigation_view_find_page);
   g_test_add_func ("/Advaita/NavigationView/animate_transitions", test_adw_navigation_view_animate_transitions);
   g_test_add_func ("/Advaita/NavigationView/pop_on_escape", test_adw_navigation_view_pop_on_escape);
+  g_test_add_func ("/Advaita/NavigationView/cache_transitions", test_adw_navigation_view_cache_transitions);
+  g_test_add_func ("/Advaita/NavigationView/retention_depth", test_adw_navigation_view_retention_depth);
   g_test_add_func ("/Advaita/NavigationPage/child", test_adw_navigation_page_child);
   g_test_add_func ("/Advaita/NavigationPage/title", test_adw_navigation_page_title);
   g_test_add_func ("/Advaita/NavigationPage/tag", test_adw_navigation_page_tag);
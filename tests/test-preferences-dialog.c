@@ -6,6 +6,7 @@
  */
 
 #include <advaita.h>
+#include "adw-preferences-search-private.h"
 
 static void
 test_adw_preferences_dialog_add_remove (void)
@@ -39,6 +40,121 @@ test_adw_preferences_dialog_add_toast (void)
   g_assert_finalize_object (toast);
 }
 
+static gboolean
+row_matches (AdwActionRow *row,
+             const char   *query)
+{
+  char *terms = adw_preferences_search_normalize (query);
+  gboolean result = adw_preferences_search_row_matches (ADW_PREFERENCES_ROW (row), terms);
+
+  g_free (terms);
+
+  return result;
+}
+
+static int
+row_score (const char *title,
+           const char *subtitle,
+           const char *query)
+{
+  AdwActionRow *row = g_object_ref_sink (ADW_ACTION_ROW (adw_action_row_new ()));
+  char *terms = adw_preferences_search_normalize (query);
+  int score;
+
+  adw_preferences_row_set_title (ADW_PREFERENCES_ROW (row), title);
+  adw_action_row_set_subtitle (row, subtitle);
+
+  score = adw_preferences_search_row_score (ADW_PREFERENCES_ROW (row), terms);
+
+  g_free (terms);
+  g_assert_finalize_object (row);
+
+  return score;
+}
+
+static int
+row_score_with_underline (const char *title,
+                          const char *query,
+                          gboolean    use_underline)
+{
+  AdwActionRow *row = g_object_ref_sink (ADW_ACTION_ROW (adw_action_row_new ()));
+  char *terms = adw_preferences_search_normalize (query);
+  int score;
+
+  adw_preferences_row_set_title (ADW_PREFERENCES_ROW (row), title);
+  adw_preferences_row_set_use_underline (ADW_PREFERENCES_ROW (row), use_underline);
+
+  score = adw_preferences_search_row_score (ADW_PREFERENCES_ROW (row), terms);
+
+  g_free (terms);
+  g_assert_finalize_object (row);
+
+  return score;
+}
+
+static void
+test_adw_preferences_dialog_search (void)
+{
+  AdwActionRow *row = g_object_ref_sink (ADW_ACTION_ROW (adw_action_row_new ()));
+  char *terms;
+  guint serial;
+  int score;
+
+  adw_preferences_row_set_title (ADW_PREFERENCES_ROW (row), "Dark _Style");
+  adw_preferences_row_set_use_underline (ADW_PREFERENCES_ROW (row), TRUE);
+  adw_action_row_set_subtitle (row, "Use a <b>dark</b> theme");
+
+  g_assert_true (row_matches (row, "DARK STYLE"));
+  g_assert_true (row_matches (row, "  style  dark "));
+  g_assert_true (row_matches (row, "dkst"));
+  g_assert_true (row_matches (row, "theme"));
+  g_assert_false (row_matches (row, "b"));
+  g_assert_false (row_matches (row, "dark contrast"));
+
+  adw_action_row_set_subtitle (row, "Use a light theme");
+  g_assert_true (row_matches (row, "light"));
+
+  /* The mnemonic only counts as part of the title without use-underline */
+  terms = adw_preferences_search_normalize ("dark style");
+  score = adw_preferences_search_row_score (ADW_PREFERENCES_ROW (row), terms);
+
+  adw_preferences_row_set_use_underline (ADW_PREFERENCES_ROW (row), FALSE);
+  g_assert_cmpint (adw_preferences_search_row_score (ADW_PREFERENCES_ROW (row), terms), <, score);
+
+  adw_preferences_row_set_use_underline (ADW_PREFERENCES_ROW (row), TRUE);
+  g_assert_cmpint (adw_preferences_search_row_score (ADW_PREFERENCES_ROW (row), terms), ==, score);
+
+  g_free (terms);
+
+  g_assert_cmpint (row_score_with_underline ("_Dark", "dark", TRUE), >, row_score_with_underline ("_Dark", "dark", FALSE));
+  g_assert_cmpint (row_score_with_underline ("Da_rk", "dark", TRUE), >, row_score_with_underline ("Da_rk", "dark", FALSE));
+
+  /* Only actual text changes make the previous results stale */
+  serial = adw_preferences_search_get_serial ();
+  adw_action_row_set_subtitle (row, "Use a light theme");
+  g_assert_cmpuint (adw_preferences_search_get_serial (), ==, serial);
+
+  adw_preferences_row_set_title (ADW_PREFERENCES_ROW (row), "High Contrast");
+  g_assert_cmpuint (adw_preferences_search_get_serial (), !=, serial);
+  g_assert_true (row_matches (row, "contrast"));
+  g_assert_false (row_matches (row, "dark"));
+
+  g_assert_finalize_object (row);
+
+  /* Exact > prefix > word start > subtitle > scattered */
+  g_assert_cmpint (row_score ("Con", "", "con"), >, row_score ("Contrast", "", "con"));
+  g_assert_cmpint (row_score ("Contrast", "", "con"), >, row_score ("High Contrast", "", "con"));
+  g_assert_cmpint (row_score ("High Contrast", "", "con"), >, row_score ("Themes", "Contrast and colors", "con"));
+  g_assert_cmpint (row_score ("Themes", "Contrast and colors", "con"), >, row_score ("Colors and Notifications", "", "con"));
+  g_assert_cmpint (row_score ("Colors and Notifications", "", "con"), >, 0);
+  g_assert_cmpint (row_score ("Themes", "", "con"), ==, 0);
+
+  g_assert_cmpint (adw_preferences_search_get_change (NULL, "a"), ==, GTK_FILTER_CHANGE_DIFFERENT);
+  g_assert_cmpint (adw_preferences_search_get_change ("da", "dar"), ==, GTK_FILTER_CHANGE_MORE_STRICT);
+  g_assert_cmpint (adw_preferences_search_get_change ("dar", "da"), ==, GTK_FILTER_CHANGE_LESS_STRICT);
+  g_assert_cmpint (adw_preferences_search_get_change ("dar", "day"), ==, GTK_FILTER_CHANGE_DIFFERENT);
+}
+
 int
 main (int   argc,
       char *argv[])
@@ -48,6 +164,7 @@ main (int   argc,
 
   g_test_add_func("/Advaita/PreferencesDialog/add_remove", test_adw_preferences_dialog_add_remove);
   g_test_add_func("/Advaita/PreferencesDialog/add_toast", test_adw_preferences_dialog_add_toast);
+  g_test_add_func("/Advaita/PreferencesDialog/search", test_adw_preferences_dialog_search);
 
   return g_test_run();
 }
@@ -0,0 +1,447 @@
+/*
+ * Copyright (C) 2024 GNOME Foundation, Inc.
+ *
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#include <advaita.h>
+#include <glib/gstdio.h>
+#include "adw-settings-impl-private.h"
+
+#define PORTAL_BUS_NAME "org.freedesktop.portal.Desktop"
+#define PORTAL_OBJECT_PATH "/org/freedesktop/portal/desktop"
+#define PORTAL_SETTINGS_INTERFACE "org.freedesktop.portal.Settings"
+
+static const char portal_xml[] =
+  "<node>"
+  "  <interface name='" PORTAL_SETTINGS_INTERFACE "'>"
+  "    <method name='ReadAll'>"
+  "      <arg type='as' name='namespaces' direction='in'/>"
+  "      <arg type='a{sa{sv}}' name='value' direction='out'/>"
+  "    </method>"
+  "    <method name='Read'>"
+  "      <arg type='s' name='namespace' direction='in'/>"
+  "      <arg type='s' name='key' direction='in'/>"
+  "      <arg type='v' name='value' direction='out'/>"
+  "    </method>"
+  "    <signal name='SettingChanged'>"
+  "      <arg type='s' name='namespace'/>"
+  "      <arg type='s' name='key'/>"
+  "      <arg type='v' name='value'/>"
+  "    </signal>"
+  "  </interface>"
+  "</node>";
+
+static GDBusConnection *portal_connection;
+static guint portal_owner_id;
+static char *cache_path;
+static int n_read_all_calls;
+static int n_read_calls;
+static guint reply_delay;
+static gboolean replied;
+
+static void
+return_settings (GDBusMethodInvocation *invocation)
+{
+  GVariantBuilder builder;
+
+  g_variant_builder_init (&builder, G_VARIANT_TYPE ("a{sa{sv}}"));
+  g_variant_builder_open (&builder, G_VARIANT_TYPE ("{sa{sv}}"));
+  g_variant_builder_add (&builder, "s", "org.freedesktop.appearance");
+  g_variant_builder_open (&builder, G_VARIANT_TYPE_VARDICT);
+  g_variant_builder_add (&builder, "{sv}", "color-scheme", g_variant_new_uint32 (1));
+  g_variant_builder_add (&builder, "{sv}", "contrast", g_variant_new_uint32 (1));
+  g_variant_builder_close (&builder);
+  g_variant_builder_close (&builder);
+
+  g_dbus_method_invocation_return_value (invocation,
+                                         g_variant_new ("(a{sa{sv}})", &builder));
+
+  replied = TRUE;
+}
+
+static void
+portal_method_call (GDBusConnection       *connection,
+                    const char            *sender,
+                    const char            *object_path,
+                    const char            *interface_name,
+                    const char            *method_name,
+                    GVariant              *parameters,
+                    GDBusMethodInvocation *invocation,
+                    gpointer               user_data)
+{
+  if (g_strcmp0 (method_name, "ReadAll")) {
+    n_read_calls++;
+
+    g_dbus_method_invocation_return_dbus_error (invocation,
+                                                "org.freedesktop.portal.Error.NotFound",
+                                                "Only ReadAll is implemented");
+    return;
+  }
+
+  n_read_all_calls++;
+
+  /* Simulate a portal that is slow to start */
+  if (reply_delay > 0) {
+    g_timeout_add_once (reply_delay, (GSourceOnceFunc) return_settings, invocation);
+    return;
+  }
+
+  return_settings (invocation);
+}
+
+static const GDBusInterfaceVTable portal_vtable = {
+  portal_method_call,
+  NULL,
+  NULL,
+};
+
+static void
+name_acquired_cb (GDBusConnection *connection,
+                  const char      *name,
+                  gboolean        *acquired)
+{
+  *acquired = TRUE;
+}
+
+static void
+start_mock_portal (GTestDBus *bus)
+{
+  GDBusNodeInfo *info;
+  GError *error = NULL;
+  gboolean acquired = FALSE;
+
+  portal_connection =
+    g_dbus_connection_new_for_address_sync (g_test_dbus_get_bus_address (bus),
+                                            G_DBUS_CONNECTION_FLAGS_AUTHENTICATION_CLIENT |
+                                            G_DBUS_CONNECTION_FLAGS_MESSAGE_BUS_CONNECTION,
+                                            NULL, NULL, &error);
+  g_assert_no_error (error);
+
+  info = g_dbus_node_info_new_for_xml (portal_xml, &error);
+  g_assert_no_error (error);
+
+  g_dbus_connection_register_object (portal_connection,
+                                     PORTAL_OBJECT_PATH,
+                                     info->interfaces[0],
+                                     &portal_vtable,
+                                     NULL, NULL, &error);
+  g_assert_no_error (error);
+
+  portal_owner_id =
+    g_bus_own_name_on_connection (portal_connection,
+                                  PORTAL_BUS_NAME,
+                                  G_BUS_NAME_OWNER_FLAGS_NONE,
+                                  (GBusNameAcquiredCallback) name_acquired_cb,
+                                  NULL, &acquired, NULL);
+
+  while (!acquired)
+    g_main_context_iteration (NULL, TRUE);
+
+  g_dbus_node_info_unref (info);
+}
+
+static void
+set_true (gboolean *flag)
+{
+  *flag = TRUE;
+}
+
+static void
+increment (int *counter)
+{
+  (*counter)++;
+}
+
+static void
+wait_for_features_changed (int *n_features_changed,
+                           int  n_expected)
+{
+  while (*n_features_changed < n_expected)
+    g_main_context_iteration (NULL, TRUE);
+
+  g_assert_cmpint (*n_features_changed, ==, n_expected);
+}
+
+static void
+wait_for_notify (AdwSettings *settings,
+                 const char  *property)
+{
+  g_autofree char *detailed_signal = g_strconcat ("notify::", property, NULL);
+  gboolean notified = FALSE;
+  gulong id;
+
+  id = g_signal_connect_swapped (settings, detailed_signal,
+                                 G_CALLBACK (set_true), &notified);
+
+  while (!notified)
+    g_main_context_iteration (NULL, TRUE);
+
+  g_signal_handler_disconnect (settings, id);
+}
+
+static void
+test_adw_settings_portal_read_all (void)
+{
+  AdwSettings *settings;
+  g_autofree char *contents = NULL;
+
+  adw_init ();
+
+  settings = adw_settings_get_default ();
+
+  /* Nothing has been dispatched yet, so adw_init() must not have waited for
+   * the portal, and the color scheme must come from the cache */
+  g_assert_cmpint (n_read_all_calls, ==, 0);
+  g_assert_true (adw_settings_get_system_supports_color_schemes (settings));
+  g_assert_cmpint (adw_settings_get_color_scheme (settings), ==, ADW_SYSTEM_COLOR_SCHEME_PREFER_LIGHT);
+
+  wait_for_notify (settings, "high-contrast");
+
+  g_assert_true (adw_settings_get_system_supports_color_schemes (settings));
+  g_assert_cmpint (adw_settings_get_color_scheme (settings), ==, ADW_SYSTEM_COLOR_SCHEME_PREFER_DARK);
+  g_assert_true (adw_settings_get_high_contrast (settings));
+
+  g_assert_cmpint (n_read_all_calls, ==, 1);
+  g_assert_cmpint (n_read_calls, ==, 0);
+
+  /* The cache is written from an idle */
+  while (g_main_context_iteration (NULL, FALSE));
+
+  g_assert_true (g_file_get_contents (cache_path, &contents, NULL, NULL));
+  g_assert_nonnull (strstr (contents, "color-scheme=prefer-dark"));
+  g_assert_nonnull (strstr (contents, "high-contrast=true"));
+}
+
+static void
+test_adw_settings_portal_changed (void)
+{
+  AdwSettings *settings = adw_settings_get_default ();
+  GError *error = NULL;
+
+  g_dbus_connection_emit_signal (portal_connection,
+                                 NULL,
+                                 PORTAL_OBJECT_PATH,
+                                 PORTAL_SETTINGS_INTERFACE,
+                                 "SettingChanged",
+                                 g_variant_new ("(ssv)",
+                                                "org.freedesktop.appearance",
+                                                "color-scheme",
+                                                g_variant_new_uint32 (2)),
+                                 &error);
+  g_assert_no_error (error);
+
+  wait_for_notify (settings, "color-scheme");
+
+  g_assert_cmpint (adw_settings_get_color_scheme (settings), ==, ADW_SYSTEM_COLOR_SCHEME_PREFER_LIGHT);
+  g_assert_cmpint (n_read_all_calls, ==, 1);
+}
+
+static void
+test_adw_settings_portal_slow (void)
+{
+  AdwSettingsImpl *impl;
+  GError *error = NULL;
+  gboolean color_scheme_changed = FALSE;
+  int n_features_changed = 0;
+  int n_calls = n_read_all_calls;
+
+  g_setenv ("ADW_PORTAL_TIMEOUT", "50", TRUE);
+  reply_delay = 500;
+  replied = FALSE;
+
+  impl = adw_settings_impl_portal_new (TRUE, TRUE);
+  g_signal_connect_swapped (impl, "features-changed",
+                            G_CALLBACK (increment), &n_features_changed);
+
+  /* The deadline passes first, so the impl must report nothing */
+  wait_for_features_changed (&n_features_changed, 1);
+
+  g_assert_false (replied);
+  g_assert_cmpint (n_read_all_calls, ==, n_calls + 1);
+  g_assert_false (adw_settings_impl_get_has_color_scheme (impl));
+  g_assert_false (adw_settings_impl_get_has_high_contrast (impl));
+
+  /* The call is still pending, and the late reply is applied */
+  wait_for_features_changed (&n_features_changed, 2);
+
+  g_assert_true (replied);
+  g_assert_cmpint (n_read_all_calls, ==, n_calls + 1);
+  g_assert_true (adw_settings_impl_get_has_color_scheme (impl));
+  g_assert_true (adw_settings_impl_get_has_high_contrast (impl));
+  g_assert_cmpint (adw_settings_impl_get_color_scheme (impl), ==, ADW_SYSTEM_COLOR_SCHEME_PREFER_DARK);
+  g_assert_true (adw_settings_impl_get_high_contrast (impl));
+
+  /* Changes are tracked as well */
+  g_signal_connect_swapped (impl, "color-scheme-changed",
+                            G_CALLBACK (set_true), &color_scheme_changed);
+
+  g_dbus_connection_emit_signal (portal_connection,
+                                 NULL,
+                                 PORTAL_OBJECT_PATH,
+                                 PORTAL_SETTINGS_INTERFACE,
+                                 "SettingChanged",
+                                 g_variant_new ("(ssv)",
+                                                "org.freedesktop.appearance",
+                                                "color-scheme",
+                                                g_variant_new_uint32 (0)),
+                                 &error);
+  g_assert_no_error (error);
+
+  while (!color_scheme_changed)
+    g_main_context_iteration (NULL, TRUE);
+
+  g_assert_cmpint (adw_settings_impl_get_color_scheme (impl), ==, ADW_SYSTEM_COLOR_SCHEME_DEFAULT);
+
+  g_object_unref (impl);
+
+  g_unsetenv ("ADW_PORTAL_TIMEOUT");
+  reply_delay = 0;
+}
+
+static void
+test_adw_settings_portal_slow_startup (void)
+{
+  AdwSettings *settings;
+  gboolean timed_out = FALSE;
+  int n_color_scheme_changed = 0;
+  int n_supports_changed = 0;
+
+  /* AdwSettings is a singleton, so start it over in a new process */
+  if (!g_test_subprocess ()) {
+    g_test_trap_subprocess (NULL, 0, G_TEST_SUBPROCESS_INHERIT_STDERR);
+    g_test_trap_assert_passed ();
+    return;
+  }
+
+  g_setenv ("ADW_PORTAL_TIMEOUT", "50", TRUE);
+  reply_delay = 500;
+
+  adw_init ();
+
+  settings = adw_settings_get_default ();
+  g_signal_connect_swapped (settings, "notify::color-scheme",
+                            G_CALLBACK (increment), &n_color_scheme_changed);
+  g_signal_connect_swapped (settings, "notify::system-supports-color-schemes",
+                            G_CALLBACK (increment), &n_supports_changed);
+
+  /* Let the deadline pass while the call is pending */
+  g_timeout_add_once (200, (GSourceOnceFunc) set_true, &timed_out);
+
+  while (!timed_out || n_read_all_calls < 1)
+    g_main_context_iteration (NULL, TRUE);
+
+  /* The cached values must stay until the portal actually answers */
+  g_assert_false (replied);
+  g_assert_true (adw_settings_get_system_supports_color_schemes (settings));
+  g_assert_cmpint (adw_settings_get_color_scheme (settings), ==, ADW_SYSTEM_COLOR_SCHEME_PREFER_LIGHT);
+  g_assert_false (adw_settings_get_high_contrast (settings));
+  g_assert_cmpint (n_color_scheme_changed, ==, 0);
+  g_assert_cmpint (n_supports_changed, ==, 0);
+
+  /* Then they go straight to the real ones */
+  wait_for_notify (settings, "high-contrast");
+
+  g_assert_true (replied);
+  g_assert_true (adw_settings_get_system_supports_color_schemes (settings));
+  g_assert_cmpint (adw_settings_get_color_scheme (settings), ==, ADW_SYSTEM_COLOR_SCHEME_PREFER_DARK);
+  g_assert_true (adw_settings_get_high_contrast (settings));
+  g_assert_cmpint (n_color_scheme_changed, ==, 1);
+  g_assert_cmpint (n_supports_changed, ==, 0);
+  g_assert_cmpint (n_read_all_calls, ==, 1);
+}
+
+static void
+test_adw_settings_portal_missing (void)
+{
+  AdwSettingsImpl *impl;
+  gboolean timed_out = FALSE;
+  int n_features_changed = 0;
+  int n_calls = n_read_all_calls;
+
+  /* This releases the name synchronously */
+  g_bus_unown_name (portal_owner_id);
+  portal_owner_id = 0;
+
+  g_setenv ("ADW_PORTAL_TIMEOUT", "50", TRUE);
+
+  impl = adw_settings_impl_portal_new (TRUE, TRUE);
+  g_signal_connect_swapped (impl, "features-changed",
+                            G_CALLBACK (increment), &n_features_changed);
+
+  wait_for_features_changed (&n_features_changed, 1);
+
+  g_assert_cmpint (n_read_all_calls, ==, n_calls);
+  g_assert_false (adw_settings_impl_get_has_color_scheme (impl));
+  g_assert_false (adw_settings_impl_get_has_high_contrast (impl));
+
+  /* The error already ended the wait, so the deadline must not fire again */
+  g_timeout_add_once (200, (GSourceOnceFunc) set_true, &timed_out);
+
+  while (!timed_out)
+    g_main_context_iteration (NULL, TRUE);
+
+  g_assert_cmpint (n_features_changed, ==, 1);
+
+  g_object_unref (impl);
+
+  g_unsetenv ("ADW_PORTAL_TIMEOUT");
+}
+
+int
+main (int   argc,
+      char *argv[])
+{
+  GTestDBus *bus;
+  char *cache_home, *cache_dir;
+  int ret;
+
+  /* Set up the cache before anything looks up the user cache directory */
+  cache_home = g_dir_make_tmp ("adw-test-cache-XXXXXX", NULL);
+  g_assert_nonnull (cache_home);
+  g_setenv ("XDG_CACHE_HOME", cache_home, TRUE);
+
+  cache_dir = g_build_filename (cache_home, "libadvaita", NULL);
+  cache_path = g_build_filename (cache_dir, "settings.ini", NULL);
+  g_assert_cmpint (g_mkdir_with_parents (cache_dir, 0700), ==, 0);
+  g_assert_true (g_file_set_contents (cache_path,
+                                      "[Settings]\n"
+                                      "color-scheme=prefer-light\n"
+                                      "high-contrast=false\n",
+                                      -1, NULL));
+
+  gtk_test_init (&argc, &argv, NULL);
+
+  g_unsetenv ("ADW_DISABLE_PORTAL");
+  g_unsetenv ("ADW_DISABLE_SETTINGS_CACHE");
+  g_unsetenv ("ADW_DEBUG_COLOR_SCHEME");
+  g_unsetenv ("ADW_DEBUG_HIGH_CONTRAST");
+
+  bus = g_test_dbus_new (G_TEST_DBUS_NONE);
+  g_test_dbus_up (bus);
+
+  start_mock_portal (bus);
+
+  g_test_add_func("/Advaita/SettingsPortal/read_all", test_adw_settings_portal_read_all);
+  g_test_add_func("/Advaita/SettingsPortal/changed", test_adw_settings_portal_changed);
+  g_test_add_func("/Advaita/SettingsPortal/slow", test_adw_settings_portal_slow);
+  g_test_add_func("/Advaita/SettingsPortal/slow_startup", test_adw_settings_portal_slow_startup);
+  g_test_add_func("/Advaita/SettingsPortal/missing", test_adw_settings_portal_missing);
+
+  ret = g_test_run ();
+
+  /* AdwSettings is a singleton and keeps the session bus alive, so don't wait
+   * for it to go away */
+  g_test_dbus_stop (bus);
+  g_object_unref (bus);
+
+  g_remove (cache_path);
+  g_rmdir (cache_dir);
+  g_rmdir (cache_home);
+
+  g_free (cache_path);
+  g_free (cache_dir);
+  g_free (cache_home);
+
+  return ret;
+}
@@ -0,0 +1,366 @@
+/*
+ * Copyright (C) 2024 GNOME Foundation, Inc.
+ *
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#include <advaita.h>
+#include "adw-swipe-tracker-private.h"
+
+/* A touchpad swipe moving at 0.5 units per ms, with irregular intervals */
+static const AdwSwipeHistoryRecord touchpad_stream[] = {
+  { 0.0, 1000 }, { 4.0, 1008 }, { 4.5, 1017 }, { 3.5, 1024 },
+  { 4.0, 1032 }, { 4.5, 1041 }, { 4.0, 1049 }, { 3.0, 1055 },
+  { 5.0, 1065 }, { 4.0, 1073 }, { 4.5, 1082 }, { 3.5, 1089 },
+  { 4.0, 1097 }, { 4.0, 1105 }, { 4.5, 1114 }, { 4.0, 1122 },
+};
+
+static double
+replay (AdwSwipeHistory             *history,
+        const AdwSwipeHistoryRecord *records,
+        gsize                        n_records)
+{
+  gsize i;
+
+  for (i = 0; i < n_records; i++)
+    adw_swipe_history_append (history, records[i].delta, records[i].time);
+
+  return adw_swipe_history_get_velocity (history);
+}
+
+static void
+test_adw_swipe_history_empty (void)
+{
+  AdwSwipeHistory history;
+
+  adw_swipe_history_clear (&history);
+  g_assert_cmpfloat_with_epsilon (adw_swipe_history_get_velocity (&history), 0, 0.001);
+
+  adw_swipe_history_append (&history, 10, 1000);
+  g_assert_cmpfloat_with_epsilon (adw_swipe_history_get_velocity (&history), 0, 0.001);
+
+  adw_swipe_history_append (&history, 10, 1000);
+  g_assert_cmpfloat_with_epsilon (adw_swipe_history_get_velocity (&history), 0, 0.001);
+}
+
+static void
+test_adw_swipe_history_two_records (void)
+{
+  AdwSwipeHistory history;
+
+  adw_swipe_history_clear (&history);
+  adw_swipe_history_append (&history, 100, 1000);
+  adw_swipe_history_append (&history, 10, 1005);
+
+  /* The first delta doesn't count, same as an average */
+  g_assert_cmpfloat_with_epsilon (adw_swipe_history_get_velocity (&history), 2, 0.0001);
+}
+
+static void
+test_adw_swipe_history_touchpad (void)
+{
+  AdwSwipeHistory history;
+  double velocity;
+
+  adw_swipe_history_clear (&history);
+  velocity = replay (&history, touchpad_stream, G_N_ELEMENTS (touchpad_stream));
+
+  g_assert_cmpfloat_with_epsilon (velocity, 0.5, 0.0001);
+}
+
+static void
+test_adw_swipe_history_mouse_1000hz (void)
+{
+  AdwSwipeHistory history;
+  guint32 i;
+
+  adw_swipe_history_clear (&history);
+
+  for (i = 0; i < 500; i++)
+    adw_swipe_history_append (&history, 2, 1000 + i);
+
+  /* Only the last 150 ms are kept */
+  g_assert_cmpuint (history.len, ==, 151);
+  g_assert_cmpfloat_with_epsilon (adw_swipe_history_get_velocity (&history), 2, 0.0001);
+}
+
+static void
+test_adw_swipe_history_jitter (void)
+{
+  AdwSwipeHistory history;
+  double velocity;
+  guint32 i;
+
+  adw_swipe_history_clear (&history);
+
+  /* Events every ms at 1.5 units per ms, but every fourth one gets delivered
+   * with a late timestamp */
+  for (i = 0; i < 300; i++)
+    adw_swipe_history_append (&history, 1.5, 1000 + i + (i % 4 == 3 ? 1 : 0));
+
+  velocity = adw_swipe_history_get_velocity (&history);
+
+  g_assert_cmpfloat_with_epsilon (velocity, 1.5, 0.05);
+}
+
+static void
+test_adw_swipe_history_overflow (void)
+{
+  AdwSwipeHistory history;
+  double velocity;
+  guint32 i;
+
+  adw_swipe_history_clear (&history);
+
+  /* 8 events per ms is more than the buffer can hold for the whole window */
+  for (i = 0; i < 800; i++)
+    adw_swipe_history_append (&history, 0.25, 1000 + i / 8);
+
+  g_assert_cmpuint (history.len, ==, ADW_SWIPE_HISTORY_SIZE);
+
+  velocity = adw_swipe_history_get_velocity (&history);
+
+  g_assert_cmpfloat_with_epsilon (velocity, 2, 0.1);
+}
+
+static void
+test_adw_swipe_history_trim (void)
+{
+  AdwSwipeHistory history;
+  guint32 i;
+
+  adw_swipe_history_clear (&history);
+
+  for (i = 0; i < 50; i++)
+    adw_swipe_history_append (&history, 1, 1000 + i * 10);
+
+  for (i = 0; i < 20; i++)
+    adw_swipe_history_append (&history, 30, 1500 + i * 10);
+
+  /* The slow part is entirely out of the window */
+  g_assert_cmpfloat_with_epsilon (adw_swipe_history_get_velocity (&history), 3, 0.0001);
+
+  adw_swipe_history_trim (&history, 5000);
+  g_assert_cmpuint (history.len, ==, 0);
+}
+
+static void
+test_adw_swipe_history_wraparound (void)
+{
+  AdwSwipeHistory history;
+  guint32 i;
+
+  adw_swipe_history_clear (&history);
+
+  for (i = 0; i < 100; i++)
+    adw_swipe_history_append (&history, 1, G_MAXUINT32 - 50 + i);
+
+  g_assert_cmpuint (history.len, ==, 100);
+  g_assert_cmpfloat_with_epsilon (adw_swipe_history_get_velocity (&history), 1, 0.0001);
+}
+
+static void
+increment (int *data)
+{
+  (*data)++;
+}
+
+static void
+end_swipe_cb (AdwSwipeTracker *tracker,
+              double           velocity,
+              double           to,
+              double          *result)
+{
+  *result = to;
+}
+
+static AdwCarousel *
+create_carousel (void)
+{
+  AdwCarousel *carousel = g_object_ref_sink (ADW_CAROUSEL (adw_carousel_new ()));
+  int i;
+
+  for (i = 0; i < 3; i++) {
+    GtkWidget *page = gtk_box_new (GTK_ORIENTATION_VERTICAL, 0);
+
+    gtk_widget_set_size_request (page, 200, 200);
+    adw_carousel_append (carousel, page);
+  }
+
+  gtk_widget_measure (GTK_WIDGET (carousel), GTK_ORIENTATION_HORIZONTAL, -1,
+                      NULL, NULL, NULL, NULL);
+  gtk_widget_measure (GTK_WIDGET (carousel), GTK_ORIENTATION_VERTICAL, 200,
+                      NULL, NULL, NULL, NULL);
+  gtk_widget_allocate (GTK_WIDGET (carousel), 200, 200, 0, NULL);
+
+  return carousel;
+}
+
+static void
+feed_drag (AdwSwipeTracker *tracker,
+           double           step_x,
+           double           step_y,
+           int              n_steps,
+           guint32          interval)
+{
+  AdwSwipeEvent event = { ADW_SWIPE_EVENT_DRAG_BEGIN, 1000, 100, 100 };
+  int i;
+
+  adw_swipe_tracker_feed_event (tracker, &event);
+
+  event.type = ADW_SWIPE_EVENT_DRAG_UPDATE;
+
+  for (i = 1; i <= n_steps; i++) {
+    event.time = 1000 + i * interval;
+    event.x = step_x * i;
+    event.y = step_y * i;
+
+    adw_swipe_tracker_feed_event (tracker, &event);
+  }
+
+  event.type = ADW_SWIPE_EVENT_DRAG_END;
+  adw_swipe_tracker_feed_event (tracker, &event);
+}
+
+static void
+test_adw_swipe_tracker_replay_fling (void)
+{
+  AdwCarousel *carousel = create_carousel ();
+  AdwSwipeTracker *tracker;
+  double to = -1;
+  int n_begin = 0;
+
+  tracker = adw_swipe_tracker_get_for_swipeable (ADW_SWIPEABLE (carousel));
+  g_assert_nonnull (tracker);
+
+  g_signal_connect_swapped (tracker, "begin-swipe", G_CALLBACK (increment), &n_begin);
+  g_signal_connect (tracker, "end-swipe", G_CALLBACK (end_swipe_cb), &to);
+
+  /* 180px in 100ms to the left, fast enough to reach the next page */
+  feed_drag (tracker, -20, 0, 10, 10);
+
+  g_assert_cmpint (n_begin, ==, 1);
+  g_assert_cmpfloat_with_epsilon (to, 1, DBL_EPSILON);
+
+  g_assert_finalize_object (carousel);
+}
+
+static void
+test_adw_swipe_tracker_replay_slow (void)
+{
+  AdwCarousel *carousel = create_carousel ();
+  AdwSwipeTracker *tracker;
+  double to = -1;
+  int n_begin = 0;
+
+  tracker = adw_swipe_tracker_get_for_swipeable (ADW_SWIPEABLE (carousel));
+
+  g_signal_connect_swapped (tracker, "begin-swipe", G_CALLBACK (increment), &n_begin);
+  g_signal_connect (tracker, "end-swipe", G_CALLBACK (end_swipe_cb), &to);
+
+  /* 60px at 0.2px per ms snaps back */
+  feed_drag (tracker, -4, 0, 15, 20);
+
+  g_assert_cmpint (n_begin, ==, 1);
+  g_assert_cmpfloat_with_epsilon (to, 0, DBL_EPSILON);
+
+  g_assert_finalize_object (carousel);
+}
+
+static void
+test_adw_swipe_tracker_replay_denied (void)
+{
+  AdwCarousel *carousel = create_carousel ();
+  AdwSwipeTracker *tracker;
+  int n_begin = 0, n_end = 0;
+
+  tracker = adw_swipe_tracker_get_for_swipeable (ADW_SWIPEABLE (carousel));
+
+  g_signal_connect_swapped (tracker, "begin-swipe", G_CALLBACK (increment), &n_begin);
+  g_signal_connect_swapped (tracker, "end-swipe", G_CALLBACK (increment), &n_end);
+
+  /* A vertical drag in a horizontal carousel */
+  feed_drag (tracker, 0, -20, 10, 10);
+
+  g_assert_cmpint (n_begin, ==, 0);
+  g_assert_cmpint (n_end, ==, 0);
+
+  /* The tracker must be ready for the next gesture */
+  feed_drag (tracker, -20, 0, 10, 10);
+
+  g_assert_cmpint (n_begin, ==, 1);
+  g_assert_cmpint (n_end, ==, 1);
+
+  g_assert_finalize_object (carousel);
+}
+
+static void
+test_adw_swipe_events_parse (void)
+{
+  GArray *events;
+  AdwSwipeEvent *event;
+  GError *error = NULL;
+
+  events = adw_swipe_events_parse ("# AdwCarousel 0x1234\n"
+                                   "drag-begin 1000 100 50.5\n"
+                                   "\n"
+                                   "drag-update 1016 -12.25 0\n"
+                                   "scroll-stop 4294967295 0 0\n",
+                                   &error);
+  g_assert_no_error (error);
+  g_assert_cmpuint (events->len, ==, 3);
+
+  event = &g_array_index (events, AdwSwipeEvent, 0);
+  g_assert_cmpint (event->type, ==, ADW_SWIPE_EVENT_DRAG_BEGIN);
+  g_assert_cmpuint (event->time, ==, 1000);
+  g_assert_cmpfloat_with_epsilon (event->x, 100, DBL_EPSILON);
+  g_assert_cmpfloat_with_epsilon (event->y, 50.5, DBL_EPSILON);
+
+  event = &g_array_index (events, AdwSwipeEvent, 1);
+  g_assert_cmpint (event->type, ==, ADW_SWIPE_EVENT_DRAG_UPDATE);
+  g_assert_cmpfloat_with_epsilon (event->x, -12.25, DBL_EPSILON);
+
+  event = &g_array_index (events, AdwSwipeEvent, 2);
+  g_assert_cmpint (event->type, ==, ADW_SWIPE_EVENT_SCROLL_STOP);
+  g_assert_cmpuint (event->time, ==, G_MAXUINT32);
+
+  g_array_unref (events);
+
+  events = adw_swipe_events_parse ("drag-begin 1000 100\n", &error);
+  g_assert_error (error, G_IO_ERROR, G_IO_ERROR_INVALID_DATA);
+  g_assert_null (events);
+  g_clear_error (&error);
+
+  events = adw_swipe_events_parse ("pinch 1000 100 100\n", &error);
+  g_assert_error (error, G_IO_ERROR, G_IO_ERROR_INVALID_DATA);
+  g_assert_null (events);
+  g_clear_error (&error);
+
+  events = adw_swipe_events_parse ("scroll 1000 1,5 0\n", &error);
+  g_assert_error (error, G_IO_ERROR, G_IO_ERROR_INVALID_DATA);
+  g_assert_null (events);
+  g_clear_error (&error);
+}
+
+int
+main (int   argc,
+      char *argv[])
+{
+  gtk_test_init (&argc, &argv, NULL);
+  adw_init ();
+
+  g_test_add_func ("/Advaita/SwipeHistory/empty", test_adw_swipe_history_empty);
+  g_test_add_func ("/Advaita/SwipeHistory/two_records", test_adw_swipe_history_two_records);
+  g_test_add_func ("/Advaita/SwipeHistory/touchpad", test_adw_swipe_history_touchpad);
+  g_test_add_func ("/Advaita/SwipeHistory/mouse_1000hz", test_adw_swipe_history_mouse_1000hz);
+  g_test_add_func ("/Advaita/SwipeHistory/jitter", test_adw_swipe_history_jitter);
+  g_test_add_func ("/Advaita/SwipeHistory/overflow", test_adw_swipe_history_overflow);
+  g_test_add_func ("/Advaita/SwipeHistory/trim", test_adw_swipe_history_trim);
+  g_test_add_func ("/Advaita/SwipeHistory/wraparound", test_adw_swipe_history_wraparound);
+  g_test_add_func ("/Advaita/SwipeTracker/replay_fling", test_adw_swipe_tracker_replay_fling);
+  g_test_add_func ("/Advaita/SwipeTracker/replay_slow", test_adw_swipe_tracker_replay_slow);
+  g_test_add_func ("/Advaita/SwipeTracker/replay_denied", test_adw_swipe_tracker_replay_denied);
+  g_test_add_func ("/Advaita/SwipeEvents/parse", test_adw_swipe_events_parse);
+
+  return g_test_run ();
+}
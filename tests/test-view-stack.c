@@ -0,0 +1,244 @@
+/*
+ * Copyright (C) 2024 GNOME Foundation, Inc.
+ *
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#include <advaita.h>
+
+#define N_PAGES 200
+
+static void
+items_changed_cb (GListModel *model,
+                  guint       position,
+                  guint       removed,
+                  guint       added,
+                  int        *n_emissions)
+{
+  (*n_emissions)++;
+}
+
+static void
+test_adw_view_stack_add_pages (void)
+{
+  AdwViewStack *stack = g_object_ref_sink (ADW_VIEW_STACK (adw_view_stack_new ()));
+  AdwViewStackPage *pages[N_PAGES];
+  GListModel *model;
+  int n_emissions = 0;
+  int i;
+
+  g_assert_nonnull (stack);
+
+  model = G_LIST_MODEL (adw_view_stack_get_pages (stack));
+  g_signal_connect (model, "items-changed", G_CALLBACK (items_changed_cb), &n_emissions);
+
+  adw_view_stack_add_named (stack, gtk_button_new (), "first");
+  g_assert_cmpint (n_emissions, ==, 1);
+
+  for (i = 0; i < N_PAGES; i++) {
+    g_autofree char *name = g_strdup_printf ("page-%d", i);
+
+    pages[i] = g_object_new (ADW_TYPE_VIEW_STACK_PAGE,
+                             "child", gtk_button_new (),
+                             "name", name,
+                             NULL);
+  }
+
+  adw_view_stack_add_pages (stack, pages, N_PAGES);
+  g_assert_cmpint (n_emissions, ==, 2);
+  g_assert_cmpuint (g_list_model_get_n_items (model), ==, N_PAGES + 1);
+
+  for (i = 0; i < N_PAGES; i++) {
+    g_autofree char *name = g_strdup_printf ("page-%d", i);
+    AdwViewStackPage *page = g_list_model_get_item (model, i + 1);
+
+    g_assert_true (page == pages[i]);
+    g_assert_true (adw_view_stack_get_child_by_name (stack, name) == adw_view_stack_page_get_child (pages[i]));
+    g_assert_true (adw_view_stack_get_page (stack, adw_view_stack_page_get_child (pages[i])) == pages[i]);
+
+    g_object_unref (page);
+    g_object_unref (pages[i]);
+  }
+
+  g_assert_cmpstr (adw_view_stack_get_visible_child_name (stack), ==, "first");
+
+  adw_view_stack_set_visible_child_name (stack, "page-100");
+  g_assert_true (adw_view_stack_get_visible_child (stack) == adw_view_stack_page_get_child (pages[100]));
+
+  g_signal_handlers_disconnect_by_func (model, items_changed_cb, &n_emissions);
+
+  g_assert_finalize_object (model);
+  g_assert_finalize_object (stack);
+}
+
+static void
+test_adw_view_stack_lookup (void)
+{
+  AdwViewStack *stack = g_object_ref_sink (ADW_VIEW_STACK (adw_view_stack_new ()));
+  GtkWidget *child1 = gtk_button_new ();
+  GtkWidget *child2 = gtk_button_new ();
+  AdwViewStackPage *page1, *page2;
+
+  g_assert_nonnull (stack);
+
+  page1 = adw_view_stack_add_named (stack, child1, "one");
+  page2 = adw_view_stack_add_named (stack, child2, "two");
+
+  g_assert_true (adw_view_stack_get_page (stack, child1) == page1);
+  g_assert_true (adw_view_stack_get_page (stack, child2) == page2);
+  g_assert_true (adw_view_stack_get_child_by_name (stack, "one") == child1);
+  g_assert_true (adw_view_stack_get_child_by_name (stack, "two") == child2);
+
+  adw_view_stack_page_set_name (page1, "renamed");
+  g_assert_null (adw_view_stack_get_child_by_name (stack, "one"));
+  g_assert_true (adw_view_stack_get_child_by_name (stack, "renamed") == child1);
+
+  adw_view_stack_page_set_name (page2, NULL);
+  g_assert_null (adw_view_stack_get_child_by_name (stack, "two"));
+
+  adw_view_stack_page_set_name (page2, "two");
+  g_assert_true (adw_view_stack_get_child_by_name (stack, "two") == child2);
+
+  adw_view_stack_remove (stack, child1);
+  g_assert_null (adw_view_stack_get_child_by_name (stack, "renamed"));
+  g_assert_null (adw_view_stack_get_page (stack, child1));
+
+  /* The stack is still appended to correctly after removing pages */
+  child1 = gtk_button_new ();
+  page1 = adw_view_stack_add_named (stack, child1, "one");
+  g_assert_true (adw_view_stack_get_child_by_name (stack, "one") == child1);
+  g_assert_true (gtk_widget_get_last_child (GTK_WIDGET (stack)) == child1);
+
+  adw_view_stack_remove (stack, child1);
+  adw_view_stack_remove (stack, child2);
+  g_assert_null (adw_view_stack_get_child_by_name (stack, "two"));
+  g_assert_null (adw_view_stack_get_visible_child (stack));
+
+  adw_view_stack_add_named (stack, gtk_button_new (), "three");
+  g_assert_cmpstr (adw_view_stack_get_visible_child_name (stack), ==, "three");
+
+  g_assert_finalize_object (stack);
+}
+
+static void
+test_adw_view_stack_duplicate_names (void)
+{
+  AdwViewStack *stack = g_object_ref_sink (ADW_VIEW_STACK (adw_view_stack_new ()));
+  GtkWidget *child1 = gtk_button_new ();
+  GtkWidget *child2 = gtk_button_new ();
+  AdwViewStackPage *page1;
+
+  page1 = adw_view_stack_add_named (stack, child1, "one");
+  adw_view_stack_add_named (stack, child2, "two");
+
+  /* Renaming an earlier page to an existing name makes it win */
+  g_test_expect_message (ADW_LOG_DOMAIN, G_LOG_LEVEL_WARNING,
+                         "Duplicate child name in AdwViewStack: two");
+  adw_view_stack_page_set_name (page1, "two");
+  g_test_assert_expected_messages ();
+
+  g_assert_null (adw_view_stack_get_child_by_name (stack, "one"));
+  g_assert_true (adw_view_stack_get_child_by_name (stack, "two") == child1);
+
+  /* And renaming it back uncovers the later page */
+  adw_view_stack_page_set_name (page1, "one");
+  g_assert_true (adw_view_stack_get_child_by_name (stack, "one") == child1);
+  g_assert_true (adw_view_stack_get_child_by_name (stack, "two") == child2);
+
+  g_test_expect_message (ADW_LOG_DOMAIN, G_LOG_LEVEL_WARNING,
+                         "Duplicate child name in AdwViewStack: two");
+  adw_view_stack_page_set_name (page1, "two");
+  g_test_assert_expected_messages ();
+
+  /* So does removing it */
+  adw_view_stack_remove (stack, child1);
+  g_assert_true (adw_view_stack_get_child_by_name (stack, "two") == child2);
+
+  g_assert_finalize_object (stack);
+}
+
+static GtkWidget *
+create_child (AdwViewStackPage *page,
+              gpointer          user_data)
+{
+  int *n_created = user_data;
+
+  (*n_created)++;
+
+  return gtk_button_new ();
+}
+
+static void
+test_adw_view_stack_lazy (void)
+{
+  AdwViewStack *stack = g_object_ref_sink (ADW_VIEW_STACK (adw_view_stack_new ()));
+  AdwViewStackPage *page1, *page2;
+  GtkWidget *bin1, *bin2, *content;
+  int n_created = 0;
+
+  g_assert_nonnull (stack);
+
+  page1 = adw_view_stack_add_lazy (stack, "one", "One", "go-home-symbolic",
+                                   create_child,
+                                   &n_created, NULL);
+  page2 = adw_view_stack_add_lazy (stack, "two", "Two", NULL,
+                                   create_child,
+                                   &n_created, NULL);
+
+  g_assert_cmpstr (adw_view_stack_page_get_title (page2), ==, "Two");
+  g_assert_cmpint (adw_view_stack_page_get_release_delay (page2), ==, -1);
+
+  bin1 = adw_view_stack_page_get_child (page1);
+  bin2 = adw_view_stack_page_get_child (page2);
+
+  /* Only the visible page has content */
+  g_assert_cmpint (n_created, ==, 1);
+  g_assert_nonnull (adw_bin_get_child (ADW_BIN (bin1)));
+  g_assert_null (adw_bin_get_child (ADW_BIN (bin2)));
+  g_assert_true (adw_view_stack_get_child_by_name (stack, "two") == bin2);
+
+  adw_view_stack_set_visible_child_name (stack, "two");
+  g_assert_cmpint (n_created, ==, 2);
+  g_assert_nonnull (adw_bin_get_child (ADW_BIN (bin2)));
+
+  /* Without a release delay, the content is kept */
+  adw_view_stack_set_visible_child_name (stack, "one");
+  while (g_main_context_iteration (NULL, FALSE));
+  g_assert_nonnull (adw_bin_get_child (ADW_BIN (bin2)));
+
+  adw_view_stack_page_set_release_delay (page2, 0);
+  g_assert_cmpint (adw_view_stack_page_get_release_delay (page2), ==, 0);
+
+  content = adw_bin_get_child (ADW_BIN (bin2));
+  g_object_add_weak_pointer (G_OBJECT (content), (gpointer *) &content);
+
+  adw_view_stack_set_visible_child_name (stack, "two");
+  adw_view_stack_set_visible_child_name (stack, "one");
+  while (g_main_context_iteration (NULL, FALSE));
+  g_assert_null (adw_bin_get_child (ADW_BIN (bin2)));
+
+  /* Released content isn't leaked */
+  g_assert_null (content);
+  g_assert_cmpint (n_created, ==, 2);
+
+  adw_view_stack_set_visible_child_name (stack, "two");
+  g_assert_cmpint (n_created, ==, 3);
+  g_assert_nonnull (adw_bin_get_child (ADW_BIN (bin2)));
+
+  g_assert_finalize_object (stack);
+}
+
+int
+main (int   argc,
+      char *argv[])
+{
+  gtk_test_init (&argc, &argv, NULL);
+  adw_init ();
+
+  g_test_add_func("/Advaita/ViewStack/add_pages", test_adw_view_stack_add_pages);
+  g_test_add_func("/Advaita/ViewStack/lookup", test_adw_view_stack_lookup);
+  g_test_add_func("/Advaita/ViewStack/duplicate_names", test_adw_view_stack_duplicate_names);
+  g_test_add_func("/Advaita/ViewStack/lazy", test_adw_view_stack_lazy);
+
+  return g_test_run();
+}
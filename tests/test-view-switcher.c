@@ -48,6 +48,55 @@ test_adw_view_switcher_stack (void)
 }
 
 
+static void
+test_adw_view_switcher_items_changed (void)
+{
+  AdwViewSwitcher *view_switcher = g_object_ref_sink (ADW_VIEW_SWITCHER (adw_view_switcher_new ()));
+  AdwViewStack *stack = g_object_ref_sink (ADW_VIEW_STACK (adw_view_stack_new ()));
+  GtkWidget *child2, *button1, *button2, *button3;
+  AdwViewStackPage *page3;
+
+  g_assert_nonnull (view_switcher);
+  g_assert_nonnull (stack);
+
+  adw_view_stack_add_titled (stack, gtk_button_new (), "one", "One");
+  child2 = gtk_button_new ();
+  adw_view_stack_add_titled (stack, child2, "two", "Two");
+
+  adw_view_switcher_set_stack (view_switcher, stack);
+
+  button1 = gtk_widget_get_first_child (GTK_WIDGET (view_switcher));
+  button2 = gtk_widget_get_next_sibling (button1);
+  g_assert_nonnull (button2);
+  g_assert_null (gtk_widget_get_next_sibling (button2));
+
+  /* Adding a page keeps the existing buttons */
+  page3 = adw_view_stack_add_titled (stack, gtk_button_new (), "three", "Three");
+  g_assert_true (gtk_widget_get_first_child (GTK_WIDGET (view_switcher)) == button1);
+  g_assert_true (gtk_widget_get_next_sibling (button1) == button2);
+
+  button3 = gtk_widget_get_next_sibling (button2);
+  g_assert_nonnull (button3);
+
+  /* And so does removing one */
+  adw_view_stack_remove (stack, child2);
+  g_assert_true (gtk_widget_get_first_child (GTK_WIDGET (view_switcher)) == button1);
+  g_assert_true (gtk_widget_get_next_sibling (button1) == button3);
+  g_assert_null (gtk_widget_get_next_sibling (button3));
+
+  /* The buttons still select the right pages after the positions change */
+  gtk_toggle_button_set_active (GTK_TOGGLE_BUTTON (button3), TRUE);
+  g_assert_cmpstr (adw_view_stack_get_visible_child_name (stack), ==, "three");
+  g_assert_false (gtk_toggle_button_get_active (GTK_TOGGLE_BUTTON (button1)));
+
+  adw_view_stack_page_set_visible (page3, FALSE);
+  g_assert_false (gtk_widget_get_visible (button3));
+
+  g_assert_finalize_object (view_switcher);
+  g_assert_finalize_object (stack);
+}
+
+
 int
 main (int   argc,
       char *argv[])
@@ -57,6 +106,7 @@ main (int   argc,
 
   g_test_add_func("/Advaita/ViewSwitcher/policy", test_adw_view_switcher_policy);
   g_test_add_func("/Advaita/ViewSwitcher/stack", test_adw_view_switcher_stack);
+  g_test_add_func("/Advaita/ViewSwitcher/items_changed", test_adw_view_switcher_items_changed);
 
   return g_test_run();
 }